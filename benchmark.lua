@@ -0,0 +1,49 @@
+local ffi = require 'ffi'
+local FILENAME = arg[1] or 'video.ts'
+local ITERATIONS = tonumber(arg[2]) or 100
+local SECTION = print
+
+local transmux = require("transmux")
+local callback = "int (*)(void *, uint8_t *, int)"
+
+local data = assert(io.open(FILENAME, "rb")):read("*a")
+
+local function extract(options)
+  local output = transmux.new_buffer()
+  local read_function = transmux.string_reader(data)
+  local write_function = ffi.cast(callback, function(opaque, buf, buf_size)
+    return output:write(buf, buf_size)
+  end)
+  transmux.extract_audio(read_function, write_function, options)
+  read_function:free()
+  write_function:free()
+end
+
+-- resident set size in MB, to spot leaks across iterations (Linux only)
+local function rss()
+  local statm = io.open("/proc/self/statm")
+  if not statm then
+    return 0
+  end
+  local pages = statm:read("*n") and statm:read("*n")
+  statm:close()
+  return pages * 4096 / 1e6
+end
+
+local function measure(name, options)
+  extract(options) -- warm up
+  local start = os.clock()
+  for i = 1, ITERATIONS do
+    extract(options)
+  end
+  local elapsed = os.clock() - start
+  print(string.format("%-24s %8.2f MB/s %8.3f ms/segment %8.1f MB RSS", name,
+    #data * ITERATIONS / elapsed / 1e6, elapsed * 1000 / ITERATIONS, rss()))
+end
+
+SECTION(string.format("extract_audio on %s (%d bytes), %d iterations", FILENAME, #data, ITERATIONS))
+
+for _, size in ipairs({4096, 8192, 65536, 262144, 1048576}) do
+  measure("buffer_size=" .. size, {read_buffer_size = size, write_buffer_size = size})
+end
+measure("default (input_size)", {input_size = #data})
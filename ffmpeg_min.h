@@ -0,0 +1,572 @@
+/* gen_cdef platform: OSX */
+typedef long long __int64_t;
+typedef long unsigned int __darwin_size_t;
+typedef long __darwin_ssize_t;
+typedef __int64_t __darwin_off_t;
+typedef __darwin_off_t off_t;
+typedef __darwin_ssize_t ssize_t;
+enum AVMediaType {
+  AVMEDIA_TYPE_UNKNOWN = - 1, AVMEDIA_TYPE_VIDEO, AVMEDIA_TYPE_AUDIO, AVMEDIA_TYPE_DATA, AVMEDIA_TYPE_SUBTITLE, AVMEDIA_TYPE_ATTACHMENT, AVMEDIA_TYPE_NB
+};
+void free (void *);
+void *malloc (size_t);
+void *realloc (void *, size_t);
+int av_strerror (int errnum, char *errbuf, size_t errbuf_size);
+void *av_malloc (size_t size);
+void av_free (void *ptr);
+typedef struct AVRational {
+  int num;
+  int den;
+} AVRational;
+enum AVRounding {
+  AV_ROUND_ZERO = 0, AV_ROUND_INF = 1, AV_ROUND_DOWN = 2, AV_ROUND_UP = 3, AV_ROUND_NEAR_INF = 5, AV_ROUND_PASS_MINMAX = 8192,
+};
+int64_t av_rescale_q (int64_t a, AVRational bq, AVRational cq);
+int64_t av_rescale_q_rnd (int64_t a, AVRational bq, AVRational cq, enum AVRounding);
+typedef struct AVClass AVClass;
+enum AVPixelFormat {
+  AV_PIX_FMT_NONE = - 1, AV_PIX_FMT_YUV420P, AV_PIX_FMT_YUYV422, AV_PIX_FMT_RGB24, AV_PIX_FMT_BGR24, AV_PIX_FMT_YUV422P, AV_PIX_FMT_YUV444P, AV_PIX_FMT_YUV410P, AV_PIX_FMT_YUV411P, AV_PIX_FMT_GRAY8, AV_PIX_FMT_MONOWHITE, AV_PIX_FMT_MONOBLACK, AV_PIX_FMT_PAL8, AV_PIX_FMT_YUVJ420P, AV_PIX_FMT_YUVJ422P, AV_PIX_FMT_YUVJ444P, AV_PIX_FMT_XVMC_MPEG2_MC, AV_PIX_FMT_XVMC_MPEG2_IDCT, AV_PIX_FMT_UYVY422, AV_PIX_FMT_UYYVYY411, AV_PIX_FMT_BGR8, AV_PIX_FMT_BGR4, AV_PIX_FMT_BGR4_BYTE, AV_PIX_FMT_RGB8, AV_PIX_FMT_RGB4, AV_PIX_FMT_RGB4_BYTE, AV_PIX_FMT_NV12, AV_PIX_FMT_NV21, AV_PIX_FMT_ARGB, AV_PIX_FMT_RGBA, AV_PIX_FMT_ABGR, AV_PIX_FMT_BGRA, AV_PIX_FMT_GRAY16BE, AV_PIX_FMT_GRAY16LE, AV_PIX_FMT_YUV440P, AV_PIX_FMT_YUVJ440P, AV_PIX_FMT_YUVA420P, AV_PIX_FMT_VDPAU_H264, AV_PIX_FMT_VDPAU_MPEG1, AV_PIX_FMT_VDPAU_MPEG2, AV_PIX_FMT_VDPAU_WMV3, AV_PIX_FMT_VDPAU_VC1, AV_PIX_FMT_RGB48BE, AV_PIX_FMT_RGB48LE, AV_PIX_FMT_RGB565BE, AV_PIX_FMT_RGB565LE, AV_PIX_FMT_RGB555BE, AV_PIX_FMT_RGB555LE, AV_PIX_FMT_BGR565BE, AV_PIX_FMT_BGR565LE, AV_PIX_FMT_BGR555BE, AV_PIX_FMT_BGR555LE, AV_PIX_FMT_VAAPI_MOCO, AV_PIX_FMT_VAAPI_IDCT, AV_PIX_FMT_VAAPI_VLD, AV_PIX_FMT_YUV420P16LE, AV_PIX_FMT_YUV420P16BE, AV_PIX_FMT_YUV422P16LE, AV_PIX_FMT_YUV422P16BE, AV_PIX_FMT_YUV444P16LE, AV_PIX_FMT_YUV444P16BE, AV_PIX_FMT_VDPAU_MPEG4, AV_PIX_FMT_DXVA2_VLD, AV_PIX_FMT_RGB444LE, AV_PIX_FMT_RGB444BE, AV_PIX_FMT_BGR444LE, AV_PIX_FMT_BGR444BE, AV_PIX_FMT_GRAY8A, AV_PIX_FMT_BGR48BE, AV_PIX_FMT_BGR48LE, AV_PIX_FMT_YUV420P9BE, AV_PIX_FMT_YUV420P9LE, AV_PIX_FMT_YUV420P10BE, AV_PIX_FMT_YUV420P10LE, AV_PIX_FMT_YUV422P10BE, AV_PIX_FMT_YUV422P10LE, AV_PIX_FMT_YUV444P9BE, AV_PIX_FMT_YUV444P9LE, AV_PIX_FMT_YUV444P10BE, AV_PIX_FMT_YUV444P10LE, AV_PIX_FMT_YUV422P9BE, AV_PIX_FMT_YUV422P9LE, AV_PIX_FMT_VDA_VLD, AV_PIX_FMT_GBRP, AV_PIX_FMT_GBRP9BE, AV_PIX_FMT_GBRP9LE, AV_PIX_FMT_GBRP10BE, AV_PIX_FMT_GBRP10LE, AV_PIX_FMT_GBRP16BE, AV_PIX_FMT_GBRP16LE, AV_PIX_FMT_YUVA422P_LIBAV, AV_PIX_FMT_YUVA444P_LIBAV, AV_PIX_FMT_YUVA420P9BE, AV_PIX_FMT_YUVA420P9LE, AV_PIX_FMT_YUVA422P9BE, AV_PIX_FMT_YUVA422P9LE, AV_PIX_FMT_YUVA444P9BE, AV_PIX_FMT_YUVA444P9LE, AV_PIX_FMT_YUVA420P10BE, AV_PIX_FMT_YUVA420P10LE, AV_PIX_FMT_YUVA422P10BE, AV_PIX_FMT_YUVA422P10LE, AV_PIX_FMT_YUVA444P10BE, AV_PIX_FMT_YUVA444P10LE, AV_PIX_FMT_YUVA420P16BE, AV_PIX_FMT_YUVA420P16LE, AV_PIX_FMT_YUVA422P16BE, AV_PIX_FMT_YUVA422P16LE, AV_PIX_FMT_YUVA444P16BE, AV_PIX_FMT_YUVA444P16LE, AV_PIX_FMT_VDPAU, AV_PIX_FMT_XYZ12LE, AV_PIX_FMT_XYZ12BE, AV_PIX_FMT_NV16, AV_PIX_FMT_NV20LE, AV_PIX_FMT_NV20BE, AV_PIX_FMT_RGBA64BE_LIBAV, AV_PIX_FMT_RGBA64LE_LIBAV, AV_PIX_FMT_BGRA64BE_LIBAV, AV_PIX_FMT_BGRA64LE_LIBAV, AV_PIX_FMT_YVYU422, AV_PIX_FMT_VDA, AV_PIX_FMT_RGBA64BE = 0x123, AV_PIX_FMT_RGBA64LE, AV_PIX_FMT_BGRA64BE, AV_PIX_FMT_BGRA64LE, AV_PIX_FMT_0RGB = 0x123 + 4, AV_PIX_FMT_RGB0, AV_PIX_FMT_0BGR, AV_PIX_FMT_BGR0, AV_PIX_FMT_YUVA444P, AV_PIX_FMT_YUVA422P, AV_PIX_FMT_YUV420P12BE, AV_PIX_FMT_YUV420P12LE, AV_PIX_FMT_YUV420P14BE, AV_PIX_FMT_YUV420P14LE, AV_PIX_FMT_YUV422P12BE, AV_PIX_FMT_YUV422P12LE, AV_PIX_FMT_YUV422P14BE, AV_PIX_FMT_YUV422P14LE, AV_PIX_FMT_YUV444P12BE, AV_PIX_FMT_YUV444P12LE, AV_PIX_FMT_YUV444P14BE, AV_PIX_FMT_YUV444P14LE, AV_PIX_FMT_GBRP12BE, AV_PIX_FMT_GBRP12LE, AV_PIX_FMT_GBRP14BE, AV_PIX_FMT_GBRP14LE, AV_PIX_FMT_GBRAP, AV_PIX_FMT_GBRAP16BE, AV_PIX_FMT_GBRAP16LE, AV_PIX_FMT_YUVJ411P, AV_PIX_FMT_BAYER_BGGR8, AV_PIX_FMT_BAYER_RGGB8, AV_PIX_FMT_BAYER_GBRG8, AV_PIX_FMT_BAYER_GRBG8, AV_PIX_FMT_BAYER_BGGR16LE, AV_PIX_FMT_BAYER_BGGR16BE, AV_PIX_FMT_BAYER_RGGB16LE, AV_PIX_FMT_BAYER_RGGB16BE, AV_PIX_FMT_BAYER_GBRG16LE, AV_PIX_FMT_BAYER_GBRG16BE, AV_PIX_FMT_BAYER_GRBG16LE, AV_PIX_FMT_BAYER_GRBG16BE, AV_PIX_FMT_NB, PIX_FMT_NONE = AV_PIX_FMT_NONE, PIX_FMT_YUV420P, PIX_FMT_YUYV422, PIX_FMT_RGB24, PIX_FMT_BGR24, PIX_FMT_YUV422P, PIX_FMT_YUV444P, PIX_FMT_YUV410P, PIX_FMT_YUV411P, PIX_FMT_GRAY8, PIX_FMT_MONOWHITE, PIX_FMT_MONOBLACK, PIX_FMT_PAL8, PIX_FMT_YUVJ420P, PIX_FMT_YUVJ422P, PIX_FMT_YUVJ444P, PIX_FMT_XVMC_MPEG2_MC, PIX_FMT_XVMC_MPEG2_IDCT, PIX_FMT_UYVY422, PIX_FMT_UYYVYY411, PIX_FMT_BGR8, PIX_FMT_BGR4, PIX_FMT_BGR4_BYTE, PIX_FMT_RGB8, PIX_FMT_RGB4, PIX_FMT_RGB4_BYTE, PIX_FMT_NV12, PIX_FMT_NV21, PIX_FMT_ARGB, PIX_FMT_RGBA, PIX_FMT_ABGR, PIX_FMT_BGRA, PIX_FMT_GRAY16BE, PIX_FMT_GRAY16LE, PIX_FMT_YUV440P, PIX_FMT_YUVJ440P, PIX_FMT_YUVA420P, PIX_FMT_VDPAU_H264, PIX_FMT_VDPAU_MPEG1, PIX_FMT_VDPAU_MPEG2, PIX_FMT_VDPAU_WMV3, PIX_FMT_VDPAU_VC1, PIX_FMT_RGB48BE, PIX_FMT_RGB48LE, PIX_FMT_RGB565BE, PIX_FMT_RGB565LE, PIX_FMT_RGB555BE, PIX_FMT_RGB555LE, PIX_FMT_BGR565BE, PIX_FMT_BGR565LE, PIX_FMT_BGR555BE, PIX_FMT_BGR555LE, PIX_FMT_VAAPI_MOCO, PIX_FMT_VAAPI_IDCT, PIX_FMT_VAAPI_VLD, PIX_FMT_YUV420P16LE, PIX_FMT_YUV420P16BE, PIX_FMT_YUV422P16LE, PIX_FMT_YUV422P16BE, PIX_FMT_YUV444P16LE, PIX_FMT_YUV444P16BE, PIX_FMT_VDPAU_MPEG4, PIX_FMT_DXVA2_VLD, PIX_FMT_RGB444LE, PIX_FMT_RGB444BE, PIX_FMT_BGR444LE, PIX_FMT_BGR444BE, PIX_FMT_GRAY8A, PIX_FMT_BGR48BE, PIX_FMT_BGR48LE, PIX_FMT_YUV420P9BE, PIX_FMT_YUV420P9LE, PIX_FMT_YUV420P10BE, PIX_FMT_YUV420P10LE, PIX_FMT_YUV422P10BE, PIX_FMT_YUV422P10LE, PIX_FMT_YUV444P9BE, PIX_FMT_YUV444P9LE, PIX_FMT_YUV444P10BE, PIX_FMT_YUV444P10LE, PIX_FMT_YUV422P9BE, PIX_FMT_YUV422P9LE, PIX_FMT_VDA_VLD, PIX_FMT_GBRP, PIX_FMT_GBRP9BE, PIX_FMT_GBRP9LE, PIX_FMT_GBRP10BE, PIX_FMT_GBRP10LE, PIX_FMT_GBRP16BE, PIX_FMT_GBRP16LE, PIX_FMT_RGBA64BE = 0x123, PIX_FMT_RGBA64LE, PIX_FMT_BGRA64BE, PIX_FMT_BGRA64LE, PIX_FMT_0RGB = 0x123 + 4, PIX_FMT_RGB0, PIX_FMT_0BGR, PIX_FMT_BGR0, PIX_FMT_YUVA444P, PIX_FMT_YUVA422P, PIX_FMT_YUV420P12BE, PIX_FMT_YUV420P12LE, PIX_FMT_YUV420P14BE, PIX_FMT_YUV420P14LE, PIX_FMT_YUV422P12BE, PIX_FMT_YUV422P12LE, PIX_FMT_YUV422P14BE, PIX_FMT_YUV422P14LE, PIX_FMT_YUV444P12BE, PIX_FMT_YUV444P12LE, PIX_FMT_YUV444P14BE, PIX_FMT_YUV444P14LE, PIX_FMT_GBRP12BE, PIX_FMT_GBRP12LE, PIX_FMT_GBRP14BE, PIX_FMT_GBRP14LE, PIX_FMT_NB,
+};
+enum AVColorPrimaries {
+  AVCOL_PRI_BT709 = 1, AVCOL_PRI_UNSPECIFIED = 2, AVCOL_PRI_RESERVED = 3, AVCOL_PRI_BT470M = 4, AVCOL_PRI_BT470BG = 5, AVCOL_PRI_SMPTE170M = 6, AVCOL_PRI_SMPTE240M = 7, AVCOL_PRI_FILM = 8, AVCOL_PRI_BT2020 = 9, AVCOL_PRI_NB,
+};
+enum AVColorTransferCharacteristic {
+  AVCOL_TRC_BT709 = 1, AVCOL_TRC_UNSPECIFIED = 2, AVCOL_TRC_RESERVED = 3, AVCOL_TRC_GAMMA22 = 4, AVCOL_TRC_GAMMA28 = 5, AVCOL_TRC_SMPTE170M = 6, AVCOL_TRC_SMPTE240M = 7, AVCOL_TRC_LINEAR = 8, AVCOL_TRC_LOG = 9, AVCOL_TRC_LOG_SQRT = 10, AVCOL_TRC_IEC61966_2_4 = 11, AVCOL_TRC_BT1361_ECG = 12, AVCOL_TRC_IEC61966_2_1 = 13, AVCOL_TRC_BT2020_10 = 14, AVCOL_TRC_BT2020_12 = 15, AVCOL_TRC_NB,
+};
+enum AVColorSpace {
+  AVCOL_SPC_RGB = 0, AVCOL_SPC_BT709 = 1, AVCOL_SPC_UNSPECIFIED = 2, AVCOL_SPC_RESERVED = 3, AVCOL_SPC_FCC = 4, AVCOL_SPC_BT470BG = 5, AVCOL_SPC_SMPTE170M = 6, AVCOL_SPC_SMPTE240M = 7, AVCOL_SPC_YCOCG = 8, AVCOL_SPC_BT2020_NCL = 9, AVCOL_SPC_BT2020_CL = 10, AVCOL_SPC_NB,
+};
+enum AVColorRange {
+  AVCOL_RANGE_UNSPECIFIED = 0, AVCOL_RANGE_MPEG = 1, AVCOL_RANGE_JPEG = 2, AVCOL_RANGE_NB,
+};
+enum AVChromaLocation {
+  AVCHROMA_LOC_UNSPECIFIED = 0, AVCHROMA_LOC_LEFT = 1, AVCHROMA_LOC_CENTER = 2, AVCHROMA_LOC_TOPLEFT = 3, AVCHROMA_LOC_TOP = 4, AVCHROMA_LOC_BOTTOMLEFT = 5, AVCHROMA_LOC_BOTTOM = 6, AVCHROMA_LOC_NB,
+};
+enum AVSampleFormat {
+  AV_SAMPLE_FMT_NONE = - 1, AV_SAMPLE_FMT_U8, AV_SAMPLE_FMT_S16, AV_SAMPLE_FMT_S32, AV_SAMPLE_FMT_FLT, AV_SAMPLE_FMT_DBL, AV_SAMPLE_FMT_U8P, AV_SAMPLE_FMT_S16P, AV_SAMPLE_FMT_S32P, AV_SAMPLE_FMT_FLTP, AV_SAMPLE_FMT_DBLP, AV_SAMPLE_FMT_NB
+};
+typedef struct AVBufferRef AVBufferRef;
+typedef struct AVDictionary AVDictionary;
+int av_dict_set (AVDictionary **pm, const char *key, const char *value, int flags);
+void av_dict_free (AVDictionary **m);
+typedef struct AVFrame AVFrame;
+enum AVCodecID {
+  AV_CODEC_ID_NONE, AV_CODEC_ID_MPEG1VIDEO, AV_CODEC_ID_MPEG2VIDEO, AV_CODEC_ID_MPEG2VIDEO_XVMC, AV_CODEC_ID_H261, AV_CODEC_ID_H263, AV_CODEC_ID_RV10, AV_CODEC_ID_RV20, AV_CODEC_ID_MJPEG, AV_CODEC_ID_MJPEGB, AV_CODEC_ID_LJPEG, AV_CODEC_ID_SP5X, AV_CODEC_ID_JPEGLS, AV_CODEC_ID_MPEG4, AV_CODEC_ID_RAWVIDEO, AV_CODEC_ID_MSMPEG4V1, AV_CODEC_ID_MSMPEG4V2, AV_CODEC_ID_MSMPEG4V3, AV_CODEC_ID_WMV1, AV_CODEC_ID_WMV2, AV_CODEC_ID_H263P, AV_CODEC_ID_H263I, AV_CODEC_ID_FLV1, AV_CODEC_ID_SVQ1, AV_CODEC_ID_SVQ3, AV_CODEC_ID_DVVIDEO, AV_CODEC_ID_HUFFYUV, AV_CODEC_ID_CYUV, AV_CODEC_ID_H264, AV_CODEC_ID_INDEO3, AV_CODEC_ID_VP3, AV_CODEC_ID_THEORA, AV_CODEC_ID_ASV1, AV_CODEC_ID_ASV2, AV_CODEC_ID_FFV1, AV_CODEC_ID_4XM, AV_CODEC_ID_VCR1, AV_CODEC_ID_CLJR, AV_CODEC_ID_MDEC, AV_CODEC_ID_ROQ, AV_CODEC_ID_INTERPLAY_VIDEO, AV_CODEC_ID_XAN_WC3, AV_CODEC_ID_XAN_WC4, AV_CODEC_ID_RPZA, AV_CODEC_ID_CINEPAK, AV_CODEC_ID_WS_VQA, AV_CODEC_ID_MSRLE, AV_CODEC_ID_MSVIDEO1, AV_CODEC_ID_IDCIN, AV_CODEC_ID_8BPS, AV_CODEC_ID_SMC, AV_CODEC_ID_FLIC, AV_CODEC_ID_TRUEMOTION1, AV_CODEC_ID_VMDVIDEO, AV_CODEC_ID_MSZH, AV_CODEC_ID_ZLIB, AV_CODEC_ID_QTRLE, AV_CODEC_ID_TSCC, AV_CODEC_ID_ULTI, AV_CODEC_ID_QDRAW, AV_CODEC_ID_VIXL, AV_CODEC_ID_QPEG, AV_CODEC_ID_PNG, AV_CODEC_ID_PPM, AV_CODEC_ID_PBM, AV_CODEC_ID_PGM, AV_CODEC_ID_PGMYUV, AV_CODEC_ID_PAM, AV_CODEC_ID_FFVHUFF, AV_CODEC_ID_RV30, AV_CODEC_ID_RV40, AV_CODEC_ID_VC1, AV_CODEC_ID_WMV3, AV_CODEC_ID_LOCO, AV_CODEC_ID_WNV1, AV_CODEC_ID_AASC, AV_CODEC_ID_INDEO2, AV_CODEC_ID_FRAPS, AV_CODEC_ID_TRUEMOTION2, AV_CODEC_ID_BMP, AV_CODEC_ID_CSCD, AV_CODEC_ID_MMVIDEO, AV_CODEC_ID_ZMBV, AV_CODEC_ID_AVS, AV_CODEC_ID_SMACKVIDEO, AV_CODEC_ID_NUV, AV_CODEC_ID_KMVC, AV_CODEC_ID_FLASHSV, AV_CODEC_ID_CAVS, AV_CODEC_ID_JPEG2000, AV_CODEC_ID_VMNC, AV_CODEC_ID_VP5, AV_CODEC_ID_VP6, AV_CODEC_ID_VP6F, AV_CODEC_ID_TARGA, AV_CODEC_ID_DSICINVIDEO, AV_CODEC_ID_TIERTEXSEQVIDEO, AV_CODEC_ID_TIFF, AV_CODEC_ID_GIF, AV_CODEC_ID_DXA, AV_CODEC_ID_DNXHD, AV_CODEC_ID_THP, AV_CODEC_ID_SGI, AV_CODEC_ID_C93, AV_CODEC_ID_BETHSOFTVID, AV_CODEC_ID_PTX, AV_CODEC_ID_TXD, AV_CODEC_ID_VP6A, AV_CODEC_ID_AMV, AV_CODEC_ID_VB, AV_CODEC_ID_PCX, AV_CODEC_ID_SUNRAST, AV_CODEC_ID_INDEO4, AV_CODEC_ID_INDEO5, AV_CODEC_ID_MIMIC, AV_CODEC_ID_RL2, AV_CODEC_ID_ESCAPE124, AV_CODEC_ID_DIRAC, AV_CODEC_ID_BFI, AV_CODEC_ID_CMV, AV_CODEC_ID_MOTIONPIXELS, AV_CODEC_ID_TGV, AV_CODEC_ID_TGQ, AV_CODEC_ID_TQI, AV_CODEC_ID_AURA, AV_CODEC_ID_AURA2, AV_CODEC_ID_V210X, AV_CODEC_ID_TMV, AV_CODEC_ID_V210, AV_CODEC_ID_DPX, AV_CODEC_ID_MAD, AV_CODEC_ID_FRWU, AV_CODEC_ID_FLASHSV2, AV_CODEC_ID_CDGRAPHICS, AV_CODEC_ID_R210, AV_CODEC_ID_ANM, AV_CODEC_ID_BINKVIDEO, AV_CODEC_ID_IFF_ILBM, AV_CODEC_ID_IFF_BYTERUN1, AV_CODEC_ID_KGV1, AV_CODEC_ID_YOP, AV_CODEC_ID_VP8, AV_CODEC_ID_PICTOR, AV_CODEC_ID_ANSI, AV_CODEC_ID_A64_MULTI, AV_CODEC_ID_A64_MULTI5, AV_CODEC_ID_R10K, AV_CODEC_ID_MXPEG, AV_CODEC_ID_LAGARITH, AV_CODEC_ID_PRORES, AV_CODEC_ID_JV, AV_CODEC_ID_DFA, AV_CODEC_ID_WMV3IMAGE, AV_CODEC_ID_VC1IMAGE, AV_CODEC_ID_UTVIDEO, AV_CODEC_ID_BMV_VIDEO, AV_CODEC_ID_VBLE, AV_CODEC_ID_DXTORY, AV_CODEC_ID_V410, AV_CODEC_ID_XWD, AV_CODEC_ID_CDXL, AV_CODEC_ID_XBM, AV_CODEC_ID_ZEROCODEC, AV_CODEC_ID_MSS1, AV_CODEC_ID_MSA1, AV_CODEC_ID_TSCC2, AV_CODEC_ID_MTS2, AV_CODEC_ID_CLLC, AV_CODEC_ID_MSS2, AV_CODEC_ID_VP9, AV_CODEC_ID_AIC, AV_CODEC_ID_ESCAPE130_DEPRECATED, AV_CODEC_ID_G2M_DEPRECATED, AV_CODEC_ID_WEBP_DEPRECATED, AV_CODEC_ID_HNM4_VIDEO, AV_CODEC_ID_HEVC_DEPRECATED, AV_CODEC_ID_FIC, AV_CODEC_ID_ALIAS_PIX, AV_CODEC_ID_BRENDER_PIX_DEPRECATED, AV_CODEC_ID_PAF_VIDEO_DEPRECATED, AV_CODEC_ID_EXR_DEPRECATED, AV_CODEC_ID_VP7_DEPRECATED, AV_CODEC_ID_SANM_DEPRECATED, AV_CODEC_ID_SGIRLE_DEPRECATED, AV_CODEC_ID_MVC1_DEPRECATED, AV_CODEC_ID_MVC2_DEPRECATED, AV_CODEC_ID_BRENDER_PIX = (('X') | (('I') << 8) | (('P') << 16) | ((unsigned) ('B') << 24)), AV_CODEC_ID_Y41P = (('P') | (('1') << 8) | (('4') << 16) | ((unsigned) ('Y') << 24)), AV_CODEC_ID_ESCAPE130 = (('0') | (('3') << 8) | (('1') << 16) | ((unsigned) ('E') << 24)), AV_CODEC_ID_EXR = (('R') | (('X') << 8) | (('E') << 16) | ((unsigned) ('0') << 24)), AV_CODEC_ID_AVRP = (('P') | (('R') << 8) | (('V') << 16) | ((unsigned) ('A') << 24)), AV_CODEC_ID_012V = (('V') | (('2') << 8) | (('1') << 16) | ((unsigned) ('0') << 24)), AV_CODEC_ID_G2M = (('M') | (('2') << 8) | (('G') << 16) | ((unsigned) (0) << 24)), AV_CODEC_ID_AVUI = (('I') | (('U') << 8) | (('V') << 16) | ((unsigned) ('A') << 24)), AV_CODEC_ID_AYUV = (('V') | (('U') << 8) | (('Y') << 16) | ((unsigned) ('A') << 24)), AV_CODEC_ID_TARGA_Y216 = (('6') | (('1') << 8) | (('2') << 16) | ((unsigned) ('T') << 24)), AV_CODEC_ID_V308 = (('8') | (('0') << 8) | (('3') << 16) | ((unsigned) ('V') << 24)), AV_CODEC_ID_V408 = (('8') | (('0') << 8) | (('4') << 16) | ((unsigned) ('V') << 24)), AV_CODEC_ID_YUV4 = (('4') | (('V') << 8) | (('U') << 16) | ((unsigned) ('Y') << 24)), AV_CODEC_ID_SANM = (('M') | (('N') << 8) | (('A') << 16) | ((unsigned) ('S') << 24)), AV_CODEC_ID_PAF_VIDEO = (('V') | (('F') << 8) | (('A') << 16) | ((unsigned) ('P') << 24)), AV_CODEC_ID_AVRN = (('n') | (('R') << 8) | (('V') << 16) | ((unsigned) ('A') << 24)), AV_CODEC_ID_CPIA = (('A') | (('I') << 8) | (('P') << 16) | ((unsigned) ('C') << 24)), AV_CODEC_ID_XFACE = (('C') | (('A') << 8) | (('F') << 16) | ((unsigned) ('X') << 24)), AV_CODEC_ID_SGIRLE = (('R') | (('I') << 8) | (('G') << 16) | ((unsigned) ('S') << 24)), AV_CODEC_ID_MVC1 = (('1') | (('C') << 8) | (('V') << 16) | ((unsigned) ('M') << 24)), AV_CODEC_ID_MVC2 = (('2') | (('C') << 8) | (('V') << 16) | ((unsigned) ('M') << 24)), AV_CODEC_ID_SNOW = (('W') | (('O') << 8) | (('N') << 16) | ((unsigned) ('S') << 24)), AV_CODEC_ID_WEBP = (('P') | (('B') << 8) | (('E') << 16) | ((unsigned) ('W') << 24)), AV_CODEC_ID_SMVJPEG = (('J') | (('V') << 8) | (('M') << 16) | ((unsigned) ('S') << 24)), AV_CODEC_ID_HEVC = (('5') | (('6') << 8) | (('2') << 16) | ((unsigned) ('H') << 24)), AV_CODEC_ID_VP7 = (('0') | (('7') << 8) | (('P') << 16) | ((unsigned) ('V') << 24)), AV_CODEC_ID_FIRST_AUDIO = 0x10000, AV_CODEC_ID_PCM_S16LE = 0x10000, AV_CODEC_ID_PCM_S16BE, AV_CODEC_ID_PCM_U16LE, AV_CODEC_ID_PCM_U16BE, AV_CODEC_ID_PCM_S8, AV_CODEC_ID_PCM_U8, AV_CODEC_ID_PCM_MULAW, AV_CODEC_ID_PCM_ALAW, AV_CODEC_ID_PCM_S32LE, AV_CODEC_ID_PCM_S32BE, AV_CODEC_ID_PCM_U32LE, AV_CODEC_ID_PCM_U32BE, AV_CODEC_ID_PCM_S24LE, AV_CODEC_ID_PCM_S24BE, AV_CODEC_ID_PCM_U24LE, AV_CODEC_ID_PCM_U24BE, AV_CODEC_ID_PCM_S24DAUD, AV_CODEC_ID_PCM_ZORK, AV_CODEC_ID_PCM_S16LE_PLANAR, AV_CODEC_ID_PCM_DVD, AV_CODEC_ID_PCM_F32BE, AV_CODEC_ID_PCM_F32LE, AV_CODEC_ID_PCM_F64BE, AV_CODEC_ID_PCM_F64LE, AV_CODEC_ID_PCM_BLURAY, AV_CODEC_ID_PCM_LXF, AV_CODEC_ID_S302M, AV_CODEC_ID_PCM_S8_PLANAR, AV_CODEC_ID_PCM_S24LE_PLANAR_DEPRECATED, AV_CODEC_ID_PCM_S32LE_PLANAR_DEPRECATED, AV_CODEC_ID_PCM_S24LE_PLANAR = (('P') | (('S') << 8) | (('P') << 16) | ((unsigned) (24) << 24)), AV_CODEC_ID_PCM_S32LE_PLANAR = (('P') | (('S') << 8) | (('P') << 16) | ((unsigned) (32) << 24)), AV_CODEC_ID_PCM_S16BE_PLANAR = ((16) | (('P') << 8) | (('S') << 16) | ((unsigned) ('P') << 24)), AV_CODEC_ID_ADPCM_IMA_QT = 0x11000, AV_CODEC_ID_ADPCM_IMA_WAV, AV_CODEC_ID_ADPCM_IMA_DK3, AV_CODEC_ID_ADPCM_IMA_DK4, AV_CODEC_ID_ADPCM_IMA_WS, AV_CODEC_ID_ADPCM_IMA_SMJPEG, AV_CODEC_ID_ADPCM_MS, AV_CODEC_ID_ADPCM_4XM, AV_CODEC_ID_ADPCM_XA, AV_CODEC_ID_ADPCM_ADX, AV_CODEC_ID_ADPCM_EA, AV_CODEC_ID_ADPCM_G726, AV_CODEC_ID_ADPCM_CT, AV_CODEC_ID_ADPCM_SWF, AV_CODEC_ID_ADPCM_YAMAHA, AV_CODEC_ID_ADPCM_SBPRO_4, AV_CODEC_ID_ADPCM_SBPRO_3, AV_CODEC_ID_ADPCM_SBPRO_2, AV_CODEC_ID_ADPCM_THP, AV_CODEC_ID_ADPCM_IMA_AMV, AV_CODEC_ID_ADPCM_EA_R1, AV_CODEC_ID_ADPCM_EA_R3, AV_CODEC_ID_ADPCM_EA_R2, AV_CODEC_ID_ADPCM_IMA_EA_SEAD, AV_CODEC_ID_ADPCM_IMA_EA_EACS, AV_CODEC_ID_ADPCM_EA_XAS, AV_CODEC_ID_ADPCM_EA_MAXIS_XA, AV_CODEC_ID_ADPCM_IMA_ISS, AV_CODEC_ID_ADPCM_G722, AV_CODEC_ID_ADPCM_IMA_APC, AV_CODEC_ID_ADPCM_VIMA_DEPRECATED, AV_CODEC_ID_ADPCM_VIMA = (('A') | (('M') << 8) | (('I') << 16) | ((unsigned) ('V') << 24)), AV_CODEC_ID_VIMA = (('A') | (('M') << 8) | (('I') << 16) | ((unsigned) ('V') << 24)), AV_CODEC_ID_ADPCM_AFC = ((' ') | (('C') << 8) | (('F') << 16) | ((unsigned) ('A') << 24)), AV_CODEC_ID_ADPCM_IMA_OKI = ((' ') | (('I') << 8) | (('K') << 16) | ((unsigned) ('O') << 24)), AV_CODEC_ID_ADPCM_DTK = ((' ') | (('K') << 8) | (('T') << 16) | ((unsigned) ('D') << 24)), AV_CODEC_ID_ADPCM_IMA_RAD = ((' ') | (('D') << 8) | (('A') << 16) | ((unsigned) ('R') << 24)), AV_CODEC_ID_ADPCM_G726LE = (('G') | (('7') << 8) | (('2') << 16) | ((unsigned) ('6') << 24)), AV_CODEC_ID_AMR_NB = 0x12000, AV_CODEC_ID_AMR_WB, AV_CODEC_ID_RA_144 = 0x13000, AV_CODEC_ID_RA_288, AV_CODEC_ID_ROQ_DPCM = 0x14000, AV_CODEC_ID_INTERPLAY_DPCM, AV_CODEC_ID_XAN_DPCM, AV_CODEC_ID_SOL_DPCM, AV_CODEC_ID_MP2 = 0x15000, AV_CODEC_ID_MP3, AV_CODEC_ID_AAC, AV_CODEC_ID_AC3, AV_CODEC_ID_DTS, AV_CODEC_ID_VORBIS, AV_CODEC_ID_DVAUDIO, AV_CODEC_ID_WMAV1, AV_CODEC_ID_WMAV2, AV_CODEC_ID_MACE3, AV_CODEC_ID_MACE6, AV_CODEC_ID_VMDAUDIO, AV_CODEC_ID_FLAC, AV_CODEC_ID_MP3ADU, AV_CODEC_ID_MP3ON4, AV_CODEC_ID_SHORTEN, AV_CODEC_ID_ALAC, AV_CODEC_ID_WESTWOOD_SND1, AV_CODEC_ID_GSM, AV_CODEC_ID_QDM2, AV_CODEC_ID_COOK, AV_CODEC_ID_TRUESPEECH, AV_CODEC_ID_TTA, AV_CODEC_ID_SMACKAUDIO, AV_CODEC_ID_QCELP, AV_CODEC_ID_WAVPACK, AV_CODEC_ID_DSICINAUDIO, AV_CODEC_ID_IMC, AV_CODEC_ID_MUSEPACK7, AV_CODEC_ID_MLP, AV_CODEC_ID_GSM_MS, AV_CODEC_ID_ATRAC3, AV_CODEC_ID_VOXWARE, AV_CODEC_ID_APE, AV_CODEC_ID_NELLYMOSER, AV_CODEC_ID_MUSEPACK8, AV_CODEC_ID_SPEEX, AV_CODEC_ID_WMAVOICE, AV_CODEC_ID_WMAPRO, AV_CODEC_ID_WMALOSSLESS, AV_CODEC_ID_ATRAC3P, AV_CODEC_ID_EAC3, AV_CODEC_ID_SIPR, AV_CODEC_ID_MP1, AV_CODEC_ID_TWINVQ, AV_CODEC_ID_TRUEHD, AV_CODEC_ID_MP4ALS, AV_CODEC_ID_ATRAC1, AV_CODEC_ID_BINKAUDIO_RDFT, AV_CODEC_ID_BINKAUDIO_DCT, AV_CODEC_ID_AAC_LATM, AV_CODEC_ID_QDMC, AV_CODEC_ID_CELT, AV_CODEC_ID_G723_1, AV_CODEC_ID_G729, AV_CODEC_ID_8SVX_EXP, AV_CODEC_ID_8SVX_FIB, AV_CODEC_ID_BMV_AUDIO, AV_CODEC_ID_RALF, AV_CODEC_ID_IAC, AV_CODEC_ID_ILBC, AV_CODEC_ID_OPUS_DEPRECATED, AV_CODEC_ID_COMFORT_NOISE, AV_CODEC_ID_TAK_DEPRECATED, AV_CODEC_ID_METASOUND, AV_CODEC_ID_PAF_AUDIO_DEPRECATED, AV_CODEC_ID_ON2AVC, AV_CODEC_ID_FFWAVESYNTH = (('S') | (('W') << 8) | (('F') << 16) | ((unsigned) ('F') << 24)), AV_CODEC_ID_SONIC = (('C') | (('N') << 8) | (('O') << 16) | ((unsigned) ('S') << 24)), AV_CODEC_ID_SONIC_LS = (('L') | (('N') << 8) | (('O') << 16) | ((unsigned) ('S') << 24)), AV_CODEC_ID_PAF_AUDIO = (('A') | (('F') << 8) | (('A') << 16) | ((unsigned) ('P') << 24)), AV_CODEC_ID_OPUS = (('S') | (('U') << 8) | (('P') << 16) | ((unsigned) ('O') << 24)), AV_CODEC_ID_TAK = (('K') | (('a') << 8) | (('B') << 16) | ((unsigned) ('t') << 24)), AV_CODEC_ID_EVRC = (('c') | (('v') << 8) | (('e') << 16) | ((unsigned) ('s') << 24)), AV_CODEC_ID_SMV = (('v') | (('m') << 8) | (('s') << 16) | ((unsigned) ('s') << 24)), AV_CODEC_ID_DSD_LSBF = (('L') | (('D') << 8) | (('S') << 16) | ((unsigned) ('D') << 24)), AV_CODEC_ID_DSD_MSBF = (('M') | (('D') << 8) | (('S') << 16) | ((unsigned) ('D') << 24)), AV_CODEC_ID_DSD_LSBF_PLANAR = (('1') | (('D') << 8) | (('S') << 16) | ((unsigned) ('D') << 24)), AV_CODEC_ID_DSD_MSBF_PLANAR = (('8') | (('D') << 8) | (('S') << 16) | ((unsigned) ('D') << 24)), AV_CODEC_ID_FIRST_SUBTITLE = 0x17000, AV_CODEC_ID_DVD_SUBTITLE = 0x17000, AV_CODEC_ID_DVB_SUBTITLE, AV_CODEC_ID_TEXT, AV_CODEC_ID_XSUB, AV_CODEC_ID_SSA, AV_CODEC_ID_MOV_TEXT, AV_CODEC_ID_HDMV_PGS_SUBTITLE, AV_CODEC_ID_DVB_TELETEXT, AV_CODEC_ID_SRT, AV_CODEC_ID_MICRODVD = (('D') | (('V') << 8) | (('D') << 16) | ((unsigned) ('m') << 24)), AV_CODEC_ID_EIA_608 = (('8') | (('0') << 8) | (('6') << 16) | ((unsigned) ('c') << 24)), AV_CODEC_ID_JACOSUB = (('B') | (('U') << 8) | (('S') << 16) | ((unsigned) ('J') << 24)), AV_CODEC_ID_SAMI = (('I') | (('M') << 8) | (('A') << 16) | ((unsigned) ('S') << 24)), AV_CODEC_ID_REALTEXT = (('T') | (('X') << 8) | (('T') << 16) | ((unsigned) ('R') << 24)), AV_CODEC_ID_SUBVIEWER1 = (('1') | (('V') << 8) | (('b') << 16) | ((unsigned) ('S') << 24)), AV_CODEC_ID_SUBVIEWER = (('V') | (('b') << 8) | (('u') << 16) | ((unsigned) ('S') << 24)), AV_CODEC_ID_SUBRIP = (('p') | (('i') << 8) | (('R') << 16) | ((unsigned) ('S') << 24)), AV_CODEC_ID_WEBVTT = (('T') | (('T') << 8) | (('V') << 16) | ((unsigned) ('W') << 24)), AV_CODEC_ID_MPL2 = (('2') | (('L') << 8) | (('P') << 16) | ((unsigned) ('M') << 24)), AV_CODEC_ID_VPLAYER = (('r') | (('l') << 8) | (('P') << 16) | ((unsigned) ('V') << 24)), AV_CODEC_ID_PJS = (('S') | (('J') << 8) | (('h') << 16) | ((unsigned) ('P') << 24)), AV_CODEC_ID_ASS = ((' ') | (('S') << 8) | (('S') << 16) | ((unsigned) ('A') << 24)), AV_CODEC_ID_FIRST_UNKNOWN = 0x18000, AV_CODEC_ID_TTF = 0x18000, AV_CODEC_ID_BINTEXT = (('T') | (('X') << 8) | (('T') << 16) | ((unsigned) ('B') << 24)), AV_CODEC_ID_XBIN = (('N') | (('I') << 8) | (('B') << 16) | ((unsigned) ('X') << 24)), AV_CODEC_ID_IDF = (('F') | (('D') << 8) | (('I') << 16) | ((unsigned) (0) << 24)), AV_CODEC_ID_OTF = (('F') | (('T') << 8) | (('O') << 16) | ((unsigned) (0) << 24)), AV_CODEC_ID_SMPTE_KLV = (('A') | (('V') << 8) | (('L') << 16) | ((unsigned) ('K') << 24)), AV_CODEC_ID_DVD_NAV = (('V') | (('A') << 8) | (('N') << 16) | ((unsigned) ('D') << 24)), AV_CODEC_ID_TIMED_ID3 = (('3') | (('D') << 8) | (('I') << 16) | ((unsigned) ('T') << 24)), AV_CODEC_ID_BIN_DATA = (('A') | (('T') << 8) | (('A') << 16) | ((unsigned) ('D') << 24)), AV_CODEC_ID_PROBE = 0x19000, AV_CODEC_ID_MPEG2TS = 0x20000, AV_CODEC_ID_MPEG4SYSTEMS = 0x20001, AV_CODEC_ID_FFMETADATA = 0x21000, CODEC_ID_NONE = AV_CODEC_ID_NONE, CODEC_ID_MPEG1VIDEO, CODEC_ID_MPEG2VIDEO, CODEC_ID_MPEG2VIDEO_XVMC, CODEC_ID_H261, CODEC_ID_H263, CODEC_ID_RV10, CODEC_ID_RV20, CODEC_ID_MJPEG, CODEC_ID_MJPEGB, CODEC_ID_LJPEG, CODEC_ID_SP5X, CODEC_ID_JPEGLS, CODEC_ID_MPEG4, CODEC_ID_RAWVIDEO, CODEC_ID_MSMPEG4V1, CODEC_ID_MSMPEG4V2, CODEC_ID_MSMPEG4V3, CODEC_ID_WMV1, CODEC_ID_WMV2, CODEC_ID_H263P, CODEC_ID_H263I, CODEC_ID_FLV1, CODEC_ID_SVQ1, CODEC_ID_SVQ3, CODEC_ID_DVVIDEO, CODEC_ID_HUFFYUV, CODEC_ID_CYUV, CODEC_ID_H264, CODEC_ID_INDEO3, CODEC_ID_VP3, CODEC_ID_THEORA, CODEC_ID_ASV1, CODEC_ID_ASV2, CODEC_ID_FFV1, CODEC_ID_4XM, CODEC_ID_VCR1, CODEC_ID_CLJR, CODEC_ID_MDEC, CODEC_ID_ROQ, CODEC_ID_INTERPLAY_VIDEO, CODEC_ID_XAN_WC3, CODEC_ID_XAN_WC4, CODEC_ID_RPZA, CODEC_ID_CINEPAK, CODEC_ID_WS_VQA, CODEC_ID_MSRLE, CODEC_ID_MSVIDEO1, CODEC_ID_IDCIN, CODEC_ID_8BPS, CODEC_ID_SMC, CODEC_ID_FLIC, CODEC_ID_TRUEMOTION1, CODEC_ID_VMDVIDEO, CODEC_ID_MSZH, CODEC_ID_ZLIB, CODEC_ID_QTRLE, CODEC_ID_TSCC, CODEC_ID_ULTI, CODEC_ID_QDRAW, CODEC_ID_VIXL, CODEC_ID_QPEG, CODEC_ID_PNG, CODEC_ID_PPM, CODEC_ID_PBM, CODEC_ID_PGM, CODEC_ID_PGMYUV, CODEC_ID_PAM, CODEC_ID_FFVHUFF, CODEC_ID_RV30, CODEC_ID_RV40, CODEC_ID_VC1, CODEC_ID_WMV3, CODEC_ID_LOCO, CODEC_ID_WNV1, CODEC_ID_AASC, CODEC_ID_INDEO2, CODEC_ID_FRAPS, CODEC_ID_TRUEMOTION2, CODEC_ID_BMP, CODEC_ID_CSCD, CODEC_ID_MMVIDEO, CODEC_ID_ZMBV, CODEC_ID_AVS, CODEC_ID_SMACKVIDEO, CODEC_ID_NUV, CODEC_ID_KMVC, CODEC_ID_FLASHSV, CODEC_ID_CAVS, CODEC_ID_JPEG2000, CODEC_ID_VMNC, CODEC_ID_VP5, CODEC_ID_VP6, CODEC_ID_VP6F, CODEC_ID_TARGA, CODEC_ID_DSICINVIDEO, CODEC_ID_TIERTEXSEQVIDEO, CODEC_ID_TIFF, CODEC_ID_GIF, CODEC_ID_DXA, CODEC_ID_DNXHD, CODEC_ID_THP, CODEC_ID_SGI, CODEC_ID_C93, CODEC_ID_BETHSOFTVID, CODEC_ID_PTX, CODEC_ID_TXD, CODEC_ID_VP6A, CODEC_ID_AMV, CODEC_ID_VB, CODEC_ID_PCX, CODEC_ID_SUNRAST, CODEC_ID_INDEO4, CODEC_ID_INDEO5, CODEC_ID_MIMIC, CODEC_ID_RL2, CODEC_ID_ESCAPE124, CODEC_ID_DIRAC, CODEC_ID_BFI, CODEC_ID_CMV, CODEC_ID_MOTIONPIXELS, CODEC_ID_TGV, CODEC_ID_TGQ, CODEC_ID_TQI, CODEC_ID_AURA, CODEC_ID_AURA2, CODEC_ID_V210X, CODEC_ID_TMV, CODEC_ID_V210, CODEC_ID_DPX, CODEC_ID_MAD, CODEC_ID_FRWU, CODEC_ID_FLASHSV2, CODEC_ID_CDGRAPHICS, CODEC_ID_R210, CODEC_ID_ANM, CODEC_ID_BINKVIDEO, CODEC_ID_IFF_ILBM, CODEC_ID_IFF_BYTERUN1, CODEC_ID_KGV1, CODEC_ID_YOP, CODEC_ID_VP8, CODEC_ID_PICTOR, CODEC_ID_ANSI, CODEC_ID_A64_MULTI, CODEC_ID_A64_MULTI5, CODEC_ID_R10K, CODEC_ID_MXPEG, CODEC_ID_LAGARITH, CODEC_ID_PRORES, CODEC_ID_JV, CODEC_ID_DFA, CODEC_ID_WMV3IMAGE, CODEC_ID_VC1IMAGE, CODEC_ID_UTVIDEO, CODEC_ID_BMV_VIDEO, CODEC_ID_VBLE, CODEC_ID_DXTORY, CODEC_ID_V410, CODEC_ID_XWD, CODEC_ID_CDXL, CODEC_ID_XBM, CODEC_ID_ZEROCODEC, CODEC_ID_MSS1, CODEC_ID_MSA1, CODEC_ID_TSCC2, CODEC_ID_MTS2, CODEC_ID_CLLC, CODEC_ID_Y41P = (('P') | (('1') << 8) | (('4') << 16) | ((unsigned) ('Y') << 24)), CODEC_ID_ESCAPE130 = (('0') | (('3') << 8) | (('1') << 16) | ((unsigned) ('E') << 24)), CODEC_ID_EXR = (('R') | (('X') << 8) | (('E') << 16) | ((unsigned) ('0') << 24)), CODEC_ID_AVRP = (('P') | (('R') << 8) | (('V') << 16) | ((unsigned) ('A') << 24)), CODEC_ID_G2M = (('M') | (('2') << 8) | (('G') << 16) | ((unsigned) (0) << 24)), CODEC_ID_AVUI = (('I') | (('U') << 8) | (('V') << 16) | ((unsigned) ('A') << 24)), CODEC_ID_AYUV = (('V') | (('U') << 8) | (('Y') << 16) | ((unsigned) ('A') << 24)), CODEC_ID_V308 = (('8') | (('0') << 8) | (('3') << 16) | ((unsigned) ('V') << 24)), CODEC_ID_V408 = (('8') | (('0') << 8) | (('4') << 16) | ((unsigned) ('V') << 24)), CODEC_ID_YUV4 = (('4') | (('V') << 8) | (('U') << 16) | ((unsigned) ('Y') << 24)), CODEC_ID_SANM = (('M') | (('N') << 8) | (('A') << 16) | ((unsigned) ('S') << 24)), CODEC_ID_PAF_VIDEO = (('V') | (('F') << 8) | (('A') << 16) | ((unsigned) ('P') << 24)), CODEC_ID_SNOW = AV_CODEC_ID_SNOW, CODEC_ID_FIRST_AUDIO = 0x10000, CODEC_ID_PCM_S16LE = 0x10000, CODEC_ID_PCM_S16BE, CODEC_ID_PCM_U16LE, CODEC_ID_PCM_U16BE, CODEC_ID_PCM_S8, CODEC_ID_PCM_U8, CODEC_ID_PCM_MULAW, CODEC_ID_PCM_ALAW, CODEC_ID_PCM_S32LE, CODEC_ID_PCM_S32BE, CODEC_ID_PCM_U32LE, CODEC_ID_PCM_U32BE, CODEC_ID_PCM_S24LE, CODEC_ID_PCM_S24BE, CODEC_ID_PCM_U24LE, CODEC_ID_PCM_U24BE, CODEC_ID_PCM_S24DAUD, CODEC_ID_PCM_ZORK, CODEC_ID_PCM_S16LE_PLANAR, CODEC_ID_PCM_DVD, CODEC_ID_PCM_F32BE, CODEC_ID_PCM_F32LE, CODEC_ID_PCM_F64BE, CODEC_ID_PCM_F64LE, CODEC_ID_PCM_BLURAY, CODEC_ID_PCM_LXF, CODEC_ID_S302M, CODEC_ID_PCM_S8_PLANAR, CODEC_ID_ADPCM_IMA_QT = 0x11000, CODEC_ID_ADPCM_IMA_WAV, CODEC_ID_ADPCM_IMA_DK3, CODEC_ID_ADPCM_IMA_DK4, CODEC_ID_ADPCM_IMA_WS, CODEC_ID_ADPCM_IMA_SMJPEG, CODEC_ID_ADPCM_MS, CODEC_ID_ADPCM_4XM, CODEC_ID_ADPCM_XA, CODEC_ID_ADPCM_ADX, CODEC_ID_ADPCM_EA, CODEC_ID_ADPCM_G726, CODEC_ID_ADPCM_CT, CODEC_ID_ADPCM_SWF, CODEC_ID_ADPCM_YAMAHA, CODEC_ID_ADPCM_SBPRO_4, CODEC_ID_ADPCM_SBPRO_3, CODEC_ID_ADPCM_SBPRO_2, CODEC_ID_ADPCM_THP, CODEC_ID_ADPCM_IMA_AMV, CODEC_ID_ADPCM_EA_R1, CODEC_ID_ADPCM_EA_R3, CODEC_ID_ADPCM_EA_R2, CODEC_ID_ADPCM_IMA_EA_SEAD, CODEC_ID_ADPCM_IMA_EA_EACS, CODEC_ID_ADPCM_EA_XAS, CODEC_ID_ADPCM_EA_MAXIS_XA, CODEC_ID_ADPCM_IMA_ISS, CODEC_ID_ADPCM_G722, CODEC_ID_ADPCM_IMA_APC, CODEC_ID_VIMA = (('A') | (('M') << 8) | (('I') << 16) | ((unsigned) ('V') << 24)), CODEC_ID_AMR_NB = 0x12000, CODEC_ID_AMR_WB, CODEC_ID_RA_144 = 0x13000, CODEC_ID_RA_288, CODEC_ID_ROQ_DPCM = 0x14000, CODEC_ID_INTERPLAY_DPCM, CODEC_ID_XAN_DPCM, CODEC_ID_SOL_DPCM, CODEC_ID_MP2 = 0x15000, CODEC_ID_MP3, CODEC_ID_AAC, CODEC_ID_AC3, CODEC_ID_DTS, CODEC_ID_VORBIS, CODEC_ID_DVAUDIO, CODEC_ID_WMAV1, CODEC_ID_WMAV2, CODEC_ID_MACE3, CODEC_ID_MACE6, CODEC_ID_VMDAUDIO, CODEC_ID_FLAC, CODEC_ID_MP3ADU, CODEC_ID_MP3ON4, CODEC_ID_SHORTEN, CODEC_ID_ALAC, CODEC_ID_WESTWOOD_SND1, CODEC_ID_GSM, CODEC_ID_QDM2, CODEC_ID_COOK, CODEC_ID_TRUESPEECH, CODEC_ID_TTA, CODEC_ID_SMACKAUDIO, CODEC_ID_QCELP, CODEC_ID_WAVPACK, CODEC_ID_DSICINAUDIO, CODEC_ID_IMC, CODEC_ID_MUSEPACK7, CODEC_ID_MLP, CODEC_ID_GSM_MS, CODEC_ID_ATRAC3, CODEC_ID_VOXWARE, CODEC_ID_APE, CODEC_ID_NELLYMOSER, CODEC_ID_MUSEPACK8, CODEC_ID_SPEEX, CODEC_ID_WMAVOICE, CODEC_ID_WMAPRO, CODEC_ID_WMALOSSLESS, CODEC_ID_ATRAC3P, CODEC_ID_EAC3, CODEC_ID_SIPR, CODEC_ID_MP1, CODEC_ID_TWINVQ, CODEC_ID_TRUEHD, CODEC_ID_MP4ALS, CODEC_ID_ATRAC1, CODEC_ID_BINKAUDIO_RDFT, CODEC_ID_BINKAUDIO_DCT, CODEC_ID_AAC_LATM, CODEC_ID_QDMC, CODEC_ID_CELT, CODEC_ID_G723_1, CODEC_ID_G729, CODEC_ID_8SVX_EXP, CODEC_ID_8SVX_FIB, CODEC_ID_BMV_AUDIO, CODEC_ID_RALF, CODEC_ID_IAC, CODEC_ID_ILBC, CODEC_ID_FFWAVESYNTH = (('S') | (('W') << 8) | (('F') << 16) | ((unsigned) ('F') << 24)), CODEC_ID_SONIC = (('C') | (('N') << 8) | (('O') << 16) | ((unsigned) ('S') << 24)), CODEC_ID_SONIC_LS = (('L') | (('N') << 8) | (('O') << 16) | ((unsigned) ('S') << 24)), CODEC_ID_PAF_AUDIO = (('A') | (('F') << 8) | (('A') << 16) | ((unsigned) ('P') << 24)), CODEC_ID_OPUS = (('S') | (('U') << 8) | (('P') << 16) | ((unsigned) ('O') << 24)), CODEC_ID_FIRST_SUBTITLE = 0x17000, CODEC_ID_DVD_SUBTITLE = 0x17000, CODEC_ID_DVB_SUBTITLE, CODEC_ID_TEXT, CODEC_ID_XSUB, CODEC_ID_SSA, CODEC_ID_MOV_TEXT, CODEC_ID_HDMV_PGS_SUBTITLE, CODEC_ID_DVB_TELETEXT, CODEC_ID_SRT, CODEC_ID_MICRODVD = (('D') | (('V') << 8) | (('D') << 16) | ((unsigned) ('m') << 24)), CODEC_ID_EIA_608 = (('8') | (('0') << 8) | (('6') << 16) | ((unsigned) ('c') << 24)), CODEC_ID_JACOSUB = (('B') | (('U') << 8) | (('S') << 16) | ((unsigned) ('J') << 24)), CODEC_ID_SAMI = (('I') | (('M') << 8) | (('A') << 16) | ((unsigned) ('S') << 24)), CODEC_ID_REALTEXT = (('T') | (('X') << 8) | (('T') << 16) | ((unsigned) ('R') << 24)), CODEC_ID_SUBVIEWER = (('V') | (('b') << 8) | (('u') << 16) | ((unsigned) ('S') << 24)), CODEC_ID_FIRST_UNKNOWN = 0x18000, CODEC_ID_TTF = 0x18000, CODEC_ID_BINTEXT = (('T') | (('X') << 8) | (('T') << 16) | ((unsigned) ('B') << 24)), CODEC_ID_XBIN = (('N') | (('I') << 8) | (('B') << 16) | ((unsigned) ('X') << 24)), CODEC_ID_IDF = (('F') | (('D') << 8) | (('I') << 16) | ((unsigned) (0) << 24)), CODEC_ID_OTF = (('F') | (('T') << 8) | (('O') << 16) | ((unsigned) (0) << 24)), CODEC_ID_PROBE = 0x19000, CODEC_ID_MPEG2TS = 0x20000, CODEC_ID_MPEG4SYSTEMS = 0x20001, CODEC_ID_FFMETADATA = 0x21000,
+};
+typedef struct AVCodecDescriptor AVCodecDescriptor;
+enum AVDiscard {
+  AVDISCARD_NONE = - 16, AVDISCARD_DEFAULT = 0, AVDISCARD_NONREF = 8, AVDISCARD_BIDIR = 16, AVDISCARD_NONINTRA = 24, AVDISCARD_NONKEY = 32, AVDISCARD_ALL = 48,
+};
+enum AVAudioServiceType {
+  AV_AUDIO_SERVICE_TYPE_MAIN = 0, AV_AUDIO_SERVICE_TYPE_EFFECTS = 1, AV_AUDIO_SERVICE_TYPE_VISUALLY_IMPAIRED = 2, AV_AUDIO_SERVICE_TYPE_HEARING_IMPAIRED = 3, AV_AUDIO_SERVICE_TYPE_DIALOGUE = 4, AV_AUDIO_SERVICE_TYPE_COMMENTARY = 5, AV_AUDIO_SERVICE_TYPE_EMERGENCY = 6, AV_AUDIO_SERVICE_TYPE_VOICE_OVER = 7, AV_AUDIO_SERVICE_TYPE_KARAOKE = 8, AV_AUDIO_SERVICE_TYPE_NB,
+};
+typedef struct RcOverride RcOverride;
+enum AVPacketSideDataType {
+  AV_PKT_DATA_PALETTE, AV_PKT_DATA_NEW_EXTRADATA, AV_PKT_DATA_PARAM_CHANGE, AV_PKT_DATA_H263_MB_INFO, AV_PKT_DATA_REPLAYGAIN, AV_PKT_DATA_DISPLAYMATRIX, AV_PKT_DATA_SKIP_SAMPLES = 70, AV_PKT_DATA_JP_DUALMONO, AV_PKT_DATA_STRINGS_METADATA, AV_PKT_DATA_SUBTITLE_POSITION, AV_PKT_DATA_MATROSKA_BLOCKADDITIONAL, AV_PKT_DATA_WEBVTT_IDENTIFIER, AV_PKT_DATA_WEBVTT_SETTINGS, AV_PKT_DATA_METADATA_UPDATE,
+};
+typedef struct AVPacketSideData {
+  uint8_t *data;
+  int size;
+  enum AVPacketSideDataType type;
+} AVPacketSideData;
+typedef struct AVPacket {
+  AVBufferRef *buf;
+  int64_t pts;
+  int64_t dts;
+  uint8_t *data;
+  int size;
+  int stream_index;
+  int flags;
+  AVPacketSideData *side_data;
+  int side_data_elems;
+  int duration;
+  void (*destruct) (struct AVPacket *);
+  void *priv;
+  int64_t pos;
+  int64_t convergence_duration;
+} AVPacket;
+struct AVCodecInternal;
+enum AVFieldOrder {
+  AV_FIELD_UNKNOWN, AV_FIELD_PROGRESSIVE, AV_FIELD_TT, AV_FIELD_BB, AV_FIELD_TB, AV_FIELD_BT,
+};
+typedef struct AVCodecContext {
+  const AVClass *av_class;
+  int log_level_offset;
+  enum AVMediaType codec_type;
+  const struct AVCodec *codec;
+  char codec_name [32];
+  enum AVCodecID codec_id;
+  unsigned int codec_tag;
+  unsigned int stream_codec_tag;
+  void *priv_data;
+  struct AVCodecInternal *internal;
+  void *opaque;
+  int bit_rate;
+  int bit_rate_tolerance;
+  int global_quality;
+  int compression_level;
+  int flags;
+  int flags2;
+  uint8_t *extradata;
+  int extradata_size;
+  AVRational time_base;
+  int ticks_per_frame;
+  int delay;
+  int width, height;
+  int coded_width, coded_height;
+  int gop_size;
+  enum AVPixelFormat pix_fmt;
+  int me_method;
+  void (*draw_horiz_band) (struct AVCodecContext *s, const AVFrame *src, int offset [8], int y, int type, int height);
+  enum AVPixelFormat (*get_format) (struct AVCodecContext *s, const enum AVPixelFormat *fmt);
+  int max_b_frames;
+  float b_quant_factor;
+  int rc_strategy;
+  int b_frame_strategy;
+  float b_quant_offset;
+  int has_b_frames;
+  int mpeg_quant;
+  float i_quant_factor;
+  float i_quant_offset;
+  float lumi_masking;
+  float temporal_cplx_masking;
+  float spatial_cplx_masking;
+  float p_masking;
+  float dark_masking;
+  int slice_count;
+  int prediction_method;
+  int *slice_offset;
+  AVRational sample_aspect_ratio;
+  int me_cmp;
+  int me_sub_cmp;
+  int mb_cmp;
+  int ildct_cmp;
+  int dia_size;
+  int last_predictor_count;
+  int pre_me;
+  int me_pre_cmp;
+  int pre_dia_size;
+  int me_subpel_quality;
+  int dtg_active_format;
+  int me_range;
+  int intra_quant_bias;
+  int inter_quant_bias;
+  int slice_flags;
+  int xvmc_acceleration;
+  int mb_decision;
+  uint16_t *intra_matrix;
+  uint16_t *inter_matrix;
+  int scenechange_threshold;
+  int noise_reduction;
+  int me_threshold;
+  int mb_threshold;
+  int intra_dc_precision;
+  int skip_top;
+  int skip_bottom;
+  float border_masking;
+  int mb_lmin;
+  int mb_lmax;
+  int me_penalty_compensation;
+  int bidir_refine;
+  int brd_scale;
+  int keyint_min;
+  int refs;
+  int chromaoffset;
+  int scenechange_factor;
+  int mv0_threshold;
+  int b_sensitivity;
+  enum AVColorPrimaries color_primaries;
+  enum AVColorTransferCharacteristic color_trc;
+  enum AVColorSpace colorspace;
+  enum AVColorRange color_range;
+  enum AVChromaLocation chroma_sample_location;
+  int slices;
+  enum AVFieldOrder field_order;
+  int sample_rate;
+  int channels;
+  enum AVSampleFormat sample_fmt;
+  int frame_size;
+  int frame_number;
+  int block_align;
+  int cutoff;
+  int request_channels;
+  uint64_t channel_layout;
+  uint64_t request_channel_layout;
+  enum AVAudioServiceType audio_service_type;
+  enum AVSampleFormat request_sample_fmt;
+  int (*get_buffer) (struct AVCodecContext *c, AVFrame *pic);
+  void (*release_buffer) (struct AVCodecContext *c, AVFrame *pic);
+  int (*reget_buffer) (struct AVCodecContext *c, AVFrame *pic);
+  int (*get_buffer2) (struct AVCodecContext *s, AVFrame *frame, int flags);
+  int refcounted_frames;
+  float qcompress;
+  float qblur;
+  int qmin;
+  int qmax;
+  int max_qdiff;
+  float rc_qsquish;
+  float rc_qmod_amp;
+  int rc_qmod_freq;
+  int rc_buffer_size;
+  int rc_override_count;
+  RcOverride *rc_override;
+  const char *rc_eq;
+  int rc_max_rate;
+  int rc_min_rate;
+  float rc_buffer_aggressivity;
+  float rc_initial_cplx;
+  float rc_max_available_vbv_use;
+  float rc_min_vbv_overflow_use;
+  int rc_initial_buffer_occupancy;
+  int coder_type;
+  int context_model;
+  int lmin;
+  int lmax;
+  int frame_skip_threshold;
+  int frame_skip_factor;
+  int frame_skip_exp;
+  int frame_skip_cmp;
+  int trellis;
+  int min_prediction_order;
+  int max_prediction_order;
+  int64_t timecode_frame_start;
+  void (*rtp_callback) (struct AVCodecContext *avctx, void *data, int size, int mb_nb);
+  int rtp_payload_size;
+  int mv_bits;
+  int header_bits;
+  int i_tex_bits;
+  int p_tex_bits;
+  int i_count;
+  int p_count;
+  int skip_count;
+  int misc_bits;
+  int frame_bits;
+  char *stats_out;
+  char *stats_in;
+  int workaround_bugs;
+  int strict_std_compliance;
+  int error_concealment;
+  int debug;
+  int debug_mv;
+  int err_recognition;
+  int64_t reordered_opaque;
+  struct AVHWAccel *hwaccel;
+  void *hwaccel_context;
+  uint64_t error [8];
+  int dct_algo;
+  int idct_algo;
+  int bits_per_coded_sample;
+  int bits_per_raw_sample;
+  int lowres;
+  AVFrame *coded_frame;
+  int thread_count;
+  int thread_type;
+  int active_thread_type;
+  int thread_safe_callbacks;
+  int (*execute) (struct AVCodecContext *c, int (*func) (struct AVCodecContext *c2, void *arg), void *arg2, int *ret, int count, int size);
+  int (*execute2) (struct AVCodecContext *c, int (*func) (struct AVCodecContext *c2, void *arg, int jobnr, int threadnr), void *arg2, int *ret, int count);
+  void *thread_opaque;
+  int nsse_weight;
+  int profile;
+  int level;
+  enum AVDiscard skip_loop_filter;
+  enum AVDiscard skip_idct;
+  enum AVDiscard skip_frame;
+  uint8_t *subtitle_header;
+  int subtitle_header_size;
+  int error_rate;
+  AVPacket *pkt;
+  uint64_t vbv_delay;
+  int side_data_only_packets;
+  AVRational pkt_timebase;
+  const AVCodecDescriptor *codec_descriptor;
+  int64_t pts_correction_num_faulty_pts;
+  int64_t pts_correction_num_faulty_dts;
+  int64_t pts_correction_last_pts;
+  int64_t pts_correction_last_dts;
+  char *sub_charenc;
+  int sub_charenc_mode;
+  int skip_alpha;
+  int seek_preroll;
+  uint16_t *chroma_intra_matrix;
+} AVCodecContext;
+typedef struct AVCodec AVCodec;
+typedef struct AVHWAccel AVHWAccel;
+AVCodecContext *avcodec_alloc_context3 (const AVCodec *codec);
+void avcodec_free_context (AVCodecContext **avctx);
+int avcodec_copy_context (AVCodecContext *dest, const AVCodecContext *src);
+void av_init_packet (AVPacket *pkt);
+int av_dup_packet (AVPacket *pkt);
+void av_free_packet (AVPacket *pkt);
+int av_packet_ref (AVPacket *dst, const AVPacket *src);
+void av_packet_unref (AVPacket *pkt);
+typedef struct AVCodecParserContext AVCodecParserContext;
+typedef struct AVIOInterruptCB {
+  int (*callback) (void *);
+  void *opaque;
+} AVIOInterruptCB;
+typedef struct AVIOContext {
+  const AVClass *av_class;
+  unsigned char *buffer;
+  int buffer_size;
+  unsigned char *buf_ptr;
+  unsigned char *buf_end;
+  void *opaque;
+  int (*read_packet) (void *opaque, uint8_t *buf, int buf_size);
+  int (*write_packet) (void *opaque, uint8_t *buf, int buf_size);
+  int64_t (*seek) (void *opaque, int64_t offset, int whence);
+  int64_t pos;
+  int must_flush;
+  int eof_reached;
+  int write_flag;
+  int max_packet_size;
+  unsigned long checksum;
+  unsigned char *checksum_ptr;
+  unsigned long (*update_checksum) (unsigned long checksum, const uint8_t *buf, unsigned int size);
+  int error;
+  int (*read_pause) (void *opaque, int pause);
+  int64_t (*read_seek) (void *opaque, int stream_index, int64_t timestamp, int flags);
+  int seekable;
+  int64_t maxsize;
+  int direct;
+  int64_t bytes_read;
+  int seek_count;
+  int writeout_count;
+  int orig_buffer_size;
+} AVIOContext;
+AVIOContext *avio_alloc_context (unsigned char *buffer, int buffer_size, int write_flag, void *opaque, int (*read_packet) (void *opaque, uint8_t *buf, int buf_size), int (*write_packet) (void *opaque, uint8_t *buf, int buf_size), int64_t (*seek) (void *opaque, int64_t offset, int whence));
+int64_t avio_seek (AVIOContext *s, int64_t offset, int whence);
+int64_t avio_size (AVIOContext *s);
+void avio_flush (AVIOContext *s);
+struct AVFormatContext;
+struct AVDeviceInfoList;
+struct AVDeviceCapabilitiesQuery;
+typedef struct AVFrac {
+  int64_t val, num, den;
+} AVFrac;
+struct AVCodecTag;
+typedef struct AVProbeData {
+  const char *filename;
+  unsigned char *buf;
+  int buf_size;
+} AVProbeData;
+typedef struct AVOutputFormat {
+  const char *name;
+  const char *long_name;
+  const char *mime_type;
+  const char *extensions;
+  enum AVCodecID audio_codec;
+  enum AVCodecID video_codec;
+  enum AVCodecID subtitle_codec;
+  int flags;
+  const struct AVCodecTag *const *codec_tag;
+  const AVClass *priv_class;
+  struct AVOutputFormat *next;
+  int priv_data_size;
+  int (*write_header) (struct AVFormatContext *);
+  int (*write_packet) (struct AVFormatContext *, AVPacket *pkt);
+  int (*write_trailer) (struct AVFormatContext *);
+  int (*interleave_packet) (struct AVFormatContext *, AVPacket *out, AVPacket *in, int flush);
+  int (*query_codec) (enum AVCodecID id, int std_compliance);
+  void (*get_output_timestamp) (struct AVFormatContext *s, int stream, int64_t *dts, int64_t *wall);
+  int (*control_message) (struct AVFormatContext *s, int type, void *data, size_t data_size);
+  int (*write_uncoded_frame) (struct AVFormatContext *, int stream_index, AVFrame **frame, unsigned flags);
+  int (*get_device_list) (struct AVFormatContext *s, struct AVDeviceInfoList *device_list);
+  int (*create_device_capabilities) (struct AVFormatContext *s, struct AVDeviceCapabilitiesQuery *caps);
+  int (*free_device_capabilities) (struct AVFormatContext *s, struct AVDeviceCapabilitiesQuery *caps);
+} AVOutputFormat;
+typedef struct AVInputFormat {
+  const char *name;
+  const char *long_name;
+  int flags;
+  const char *extensions;
+  const struct AVCodecTag *const *codec_tag;
+  const AVClass *priv_class;
+  struct AVInputFormat *next;
+  int raw_codec_id;
+  int priv_data_size;
+  int (*read_probe) (AVProbeData *);
+  int (*read_header) (struct AVFormatContext *);
+  int (*read_packet) (struct AVFormatContext *, AVPacket *pkt);
+  int (*read_close) (struct AVFormatContext *);
+  int (*read_seek) (struct AVFormatContext *, int stream_index, int64_t timestamp, int flags);
+  int64_t (*read_timestamp) (struct AVFormatContext *s, int stream_index, int64_t *pos, int64_t pos_limit);
+  int (*read_play) (struct AVFormatContext *);
+  int (*read_pause) (struct AVFormatContext *);
+  int (*read_seek2) (struct AVFormatContext *s, int stream_index, int64_t min_ts, int64_t ts, int64_t max_ts, int flags);
+  int (*get_device_list) (struct AVFormatContext *s, struct AVDeviceInfoList *device_list);
+  int (*create_device_capabilities) (struct AVFormatContext *s, struct AVDeviceCapabilitiesQuery *caps);
+  int (*free_device_capabilities) (struct AVFormatContext *s, struct AVDeviceCapabilitiesQuery *caps);
+} AVInputFormat;
+enum AVStreamParseType {
+  AVSTREAM_PARSE_NONE, AVSTREAM_PARSE_FULL, AVSTREAM_PARSE_HEADERS, AVSTREAM_PARSE_TIMESTAMPS, AVSTREAM_PARSE_FULL_ONCE, AVSTREAM_PARSE_FULL_RAW = ((0) | (('R') << 8) | (('A') << 16) | ((unsigned) ('W') << 24)),
+};
+typedef struct AVIndexEntry AVIndexEntry;
+typedef struct AVStream {
+  int index;
+  int id;
+  AVCodecContext *codec;
+  void *priv_data;
+  struct AVFrac pts;
+  AVRational time_base;
+  int64_t start_time;
+  int64_t duration;
+  int64_t nb_frames;
+  int disposition;
+  enum AVDiscard discard;
+  AVRational sample_aspect_ratio;
+  AVDictionary *metadata;
+  AVRational avg_frame_rate;
+  AVPacket attached_pic;
+  AVPacketSideData *side_data;
+  int nb_side_data;
+  struct {
+    int64_t last_dts;
+    int64_t duration_gcd;
+    int duration_count;
+    int64_t rfps_duration_sum;
+    double (*duration_error) [2] [(60 *12 + 6)];
+    int64_t codec_info_duration;
+    int64_t codec_info_duration_fields;
+    int found_decoder;
+    int64_t last_duration;
+    int64_t fps_first_dts;
+    int fps_first_dts_idx;
+    int64_t fps_last_dts;
+    int fps_last_dts_idx;
+  } *info;
+  int pts_wrap_bits;
+  int64_t do_not_use;
+  int64_t first_dts;
+  int64_t cur_dts;
+  int64_t last_IP_pts;
+  int last_IP_duration;
+  int probe_packets;
+  int codec_info_nb_frames;
+  enum AVStreamParseType need_parsing;
+  struct AVCodecParserContext *parser;
+  struct AVPacketList *last_in_packet_buffer;
+  AVProbeData probe_data;
+  int64_t pts_buffer [16 + 1];
+  AVIndexEntry *index_entries;
+  int nb_index_entries;
+  unsigned int index_entries_allocated_size;
+  AVRational r_frame_rate;
+  int stream_identifier;
+  int64_t interleaver_chunk_size;
+  int64_t interleaver_chunk_duration;
+  int request_probe;
+  int skip_to_keyframe;
+  int skip_samples;
+  int nb_decoded_frames;
+  int64_t mux_ts_offset;
+  int64_t pts_wrap_reference;
+  int pts_wrap_behavior;
+  int update_initial_durations_done;
+  int64_t pts_reorder_error [16 + 1];
+  uint8_t pts_reorder_error_count [16 + 1];
+  int64_t last_dts_for_order_check;
+  uint8_t dts_ordered;
+  uint8_t dts_misordered;
+  int inject_global_side_data;
+} AVStream;
+typedef struct AVProgram AVProgram;
+typedef struct AVChapter AVChapter;
+typedef int (*av_format_control_message) (struct AVFormatContext *s, int type, void *data, size_t data_size);
+enum AVDurationEstimationMethod {
+  AVFMT_DURATION_FROM_PTS, AVFMT_DURATION_FROM_STREAM, AVFMT_DURATION_FROM_BITRATE
+};
+typedef struct AVFormatInternal AVFormatInternal;
+typedef struct AVFormatContext {
+  const AVClass *av_class;
+  struct AVInputFormat *iformat;
+  struct AVOutputFormat *oformat;
+  void *priv_data;
+  AVIOContext *pb;
+  int ctx_flags;
+  unsigned int nb_streams;
+  AVStream **streams;
+  char filename [1024];
+  int64_t start_time;
+  int64_t duration;
+  int bit_rate;
+  unsigned int packet_size;
+  int max_delay;
+  int flags;
+  unsigned int probesize;
+  int max_analyze_duration;
+  const uint8_t *key;
+  int keylen;
+  unsigned int nb_programs;
+  AVProgram **programs;
+  enum AVCodecID video_codec_id;
+  enum AVCodecID audio_codec_id;
+  enum AVCodecID subtitle_codec_id;
+  unsigned int max_index_size;
+  unsigned int max_picture_buffer;
+  unsigned int nb_chapters;
+  AVChapter **chapters;
+  AVDictionary *metadata;
+  int64_t start_time_realtime;
+  int fps_probe_size;
+  int error_recognition;
+  AVIOInterruptCB interrupt_callback;
+  int debug;
+  int64_t max_interleave_delta;
+  int strict_std_compliance;
+  int ts_id;
+  int audio_preload;
+  int max_chunk_duration;
+  int max_chunk_size;
+  int use_wallclock_as_timestamps;
+  int avoid_negative_ts;
+  int avio_flags;
+  enum AVDurationEstimationMethod duration_estimation_method;
+  int64_t skip_initial_bytes;
+  unsigned int correct_ts_overflow;
+  int seek2any;
+  int flush_packets;
+  int probe_score;
+  int format_probesize;
+  struct AVPacketList *packet_buffer;
+  struct AVPacketList *packet_buffer_end;
+  int64_t data_offset;
+  struct AVPacketList *raw_packet_buffer;
+  struct AVPacketList *raw_packet_buffer_end;
+  struct AVPacketList *parse_queue;
+  struct AVPacketList *parse_queue_end;
+  int raw_packet_buffer_remaining_size;
+  int64_t offset;
+  AVRational offset_timebase;
+  AVFormatInternal *internal;
+  int io_repositioned;
+  AVCodec *video_codec;
+  AVCodec *audio_codec;
+  AVCodec *subtitle_codec;
+  int metadata_header_padding;
+  void *opaque;
+  av_format_control_message control_message_cb;
+  int64_t output_ts_offset;
+  int64_t max_analyze_duration2;
+} AVFormatContext;
+typedef struct AVPacketList AVPacketList;
+unsigned avformat_version (void);
+void av_register_all (void);
+AVFormatContext *avformat_alloc_context (void);
+void avformat_free_context (AVFormatContext *s);
+AVStream *avformat_new_stream (AVFormatContext *s, const AVCodec *c);
+AVInputFormat *av_find_input_format (const char *short_name);
+int avformat_open_input (AVFormatContext **ps, const char *filename, AVInputFormat *fmt, AVDictionary **options);
+int av_find_stream_info (AVFormatContext *ic);
+int avformat_find_stream_info (AVFormatContext *ic, AVDictionary **options);
+int av_find_best_stream (AVFormatContext *ic, enum AVMediaType type, int wanted_stream_nb, int related_stream, AVCodec **decoder_ret, int flags);
+int av_read_frame (AVFormatContext *s, AVPacket *pkt);
+int av_seek_frame (AVFormatContext *s, int stream_index, int64_t timestamp, int flags);
+int avformat_seek_file (AVFormatContext *s, int stream_index, int64_t min_ts, int64_t ts, int64_t max_ts, int flags);
+void avformat_close_input (AVFormatContext **s);
+int avformat_write_header (AVFormatContext *s, AVDictionary **options);
+int av_write_frame (AVFormatContext *s, AVPacket *pkt);
+int av_interleaved_write_frame (AVFormatContext *s, AVPacket *pkt);
+int av_write_trailer (AVFormatContext *s);
+AVOutputFormat *av_guess_format (const char *short_name, const char *filename, const char *mime_type);
+void av_dump_format (AVFormatContext *ic, int index, const char *url, int is_output);
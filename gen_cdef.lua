@@ -0,0 +1,389 @@
+-- Builds the minimal cdef transmux.lua needs out of a preprocessed ffmpeg
+-- header: only the declarations reachable from the av*/AV* names used by
+-- the given Lua sources, with __attribute__/__asm stripped and inline
+-- function bodies dropped.
+--
+--   gcc -E -I $PATH_TO_FFMPEG_SRC tmp.h > ffmpeg_full.h
+--   luajit gen_cdef.lua ffmpeg_full.h transmux.lua > ffmpeg_min.h
+--
+-- Structs only reached through pointers are declared opaque, except for
+-- the ones transmux.lua reads fields of (COMPLETE below).
+local INPUT = assert(arg[1], "usage: gen_cdef.lua preprocessed.h source.lua...")
+
+-- names transmux.lua uses from libc and the posix cdef relies on
+local EXTRA_ROOTS = {"off_t", "ssize_t", "malloc", "realloc", "free"}
+
+-- structs accessed by field through a pointer
+local COMPLETE = {
+  "AVFormatContext", "AVStream", "AVCodecContext", "AVCodecParameters", "AVPacket",
+  "AVIOContext", "AVInputFormat", "AVOutputFormat", "AVRational", "AVPacketSideData",
+}
+
+-- types LuaJIT knows already, redefining them only costs parse time
+local BUILTIN = {}
+for name in ([[
+  int8_t int16_t int32_t int64_t uint8_t uint16_t uint32_t uint64_t
+  intptr_t uintptr_t ptrdiff_t size_t wchar_t va_list __builtin_va_list __gnuc_va_list
+]]):gmatch("%S+") do
+  BUILTIN[name] = true
+end
+
+local KEYWORDS = {}
+for name in ([[
+  auto break case char const continue default do double else enum extern float for goto if
+  inline int long register restrict return short signed sizeof static struct switch typedef
+  union unsigned void volatile while _Bool __builtin_va_list
+]]):gmatch("%S+") do
+  KEYWORDS[name] = true
+end
+
+local DROPPED = {
+  __restrict = true, __restrict__ = true, restrict = true, __extension__ = true,
+  __inline = true, __inline__ = true, _Nullable = true, _Nonnull = true, _Null_unspecified = true,
+}
+local WITH_ARGUMENTS = {__attribute__ = true, __attribute = true, __asm__ = true, __asm = true, asm = true,
+  __declspec = true}
+
+local function tokenize(text)
+  local tokens = {}
+  local i, n = 1, #text
+  while i <= n do
+    local s, e = text:find("^%s+", i)
+    if s then
+      i = e + 1
+    else
+      local token
+      for _, pattern in ipairs({"^[%a_][%w_]*", "^%d[%w_.]*", '^"[^"]*"', "^'[^']*'", "^%.%.%.", "^->", "^<<", "^>>", "^."}) do
+        s, e = text:find(pattern, i)
+        if s then
+          token = text:sub(s, e)
+          break
+        end
+      end
+      tokens[#tokens + 1] = token
+      i = e + 1
+    end
+  end
+  return tokens
+end
+
+-- drops attributes, asm labels and qualifiers LuaJIT does not need
+local function clean(tokens)
+  local out = {}
+  local i = 1
+  while i <= #tokens do
+    local token = tokens[i]
+    if WITH_ARGUMENTS[token] then
+      local depth = 0
+      repeat
+        i = i + 1
+        if tokens[i] == "(" then
+          depth = depth + 1
+        elseif tokens[i] == ")" then
+          depth = depth - 1
+        end
+      until depth == 0 or i > #tokens
+    elseif not DROPPED[token] then
+      out[#out + 1] = token
+    end
+    i = i + 1
+  end
+  return out
+end
+
+-- top level declarations; function definitions are flagged to be skipped
+local function split(tokens)
+  local chunks = {}
+  local chunk = {}
+  local braces, parens = 0, 0
+  local body_opened_after_paren = false
+  for _, token in ipairs(tokens) do
+    if token == "{" then
+      if braces == 0 then
+        body_opened_after_paren = chunk[#chunk] == ")"
+      end
+      braces = braces + 1
+    elseif token == "}" then
+      braces = braces - 1
+    elseif token == "(" then
+      parens = parens + 1
+    elseif token == ")" then
+      parens = parens - 1
+    end
+    chunk[#chunk + 1] = token
+    if braces == 0 and parens == 0 then
+      if token == ";" then
+        chunks[#chunks + 1] = {tokens = chunk}
+        chunk = {}
+      elseif token == "}" and body_opened_after_paren then
+        chunks[#chunks + 1] = {tokens = chunk, definition = true}
+        chunk = {}
+        body_opened_after_paren = false
+      end
+    end
+  end
+  return chunks
+end
+
+local function is_identifier(token)
+  return token and token:match("^[%a_][%w_]*$") and not KEYWORDS[token]
+end
+
+local TAGS = {struct = true, union = true, enum = true}
+
+-- body boundaries of the first struct/union/enum body at brace depth 0
+local function find_body(tokens)
+  for i, token in ipairs(tokens) do
+    if token == "{" then
+      local depth = 0
+      for j = i, #tokens do
+        if tokens[j] == "{" then
+          depth = depth + 1
+        elseif tokens[j] == "}" then
+          depth = depth - 1
+          if depth == 0 then
+            return i, j
+          end
+        end
+      end
+    end
+  end
+end
+
+-- name of each declarator in tokens[first..last], split on top level commas
+local function declarator_names(tokens, first, last)
+  local names = {}
+  local depth, candidate, before_paren = 0, nil, nil
+  local function flush()
+    local name = before_paren or candidate
+    if name then
+      names[#names + 1] = name
+    end
+    candidate, before_paren = nil, nil
+  end
+  for i = first, last do
+    local token = tokens[i]
+    if token == "(" then
+      if depth == 0 and not before_paren then
+        if tokens[i + 1] == "*" and is_identifier(tokens[i + 2]) then
+          before_paren = tokens[i + 2]
+        elseif candidate then
+          before_paren = candidate
+        end
+      end
+      depth = depth + 1
+    elseif token == ")" then
+      depth = depth - 1
+    elseif token == "[" then
+      depth = depth + 1
+    elseif token == "]" then
+      depth = depth - 1
+    elseif depth == 0 then
+      if token == "," or token == ";" then
+        flush()
+      elseif is_identifier(token) and not TAGS[tokens[i - 1]] then
+        candidate = token
+      end
+    end
+  end
+  flush()
+  return names
+end
+
+local function analyze(chunk)
+  local tokens = chunk.tokens
+  local defines = {}
+  local body_start, body_end = find_body(tokens)
+  local tag_keyword = body_start and tokens[body_start - 1]
+  local tag
+
+  -- struct/union/enum tag, with or without a body
+  for i, token in ipairs(tokens) do
+    if TAGS[token] and is_identifier(tokens[i + 1]) and (not body_start or i < body_start) then
+      if body_start and i + 2 == body_start or (not body_start and tokens[1] ~= "typedef" and tokens[i + 2] == ";") then
+        tag = "tag:" .. tokens[i + 1]
+        defines[#defines + 1] = tag
+      end
+      break
+    end
+  end
+
+  if body_start then
+    local keyword = TAGS[tag_keyword] and tag_keyword or tokens[body_start - 2]
+    chunk.enum = keyword == "enum"
+    if chunk.enum then
+      for i = body_start + 1, body_end - 1 do
+        if is_identifier(tokens[i]) and (tokens[i - 1] == "{" or tokens[i - 1] == ",") then
+          defines[#defines + 1] = tokens[i]
+        end
+      end
+    end
+  end
+
+  if tokens[1] == "typedef" then
+    chunk.typedef = true
+    for _, name in ipairs(declarator_names(tokens, (body_end or 1) + 1, #tokens)) do
+      defines[#defines + 1] = name
+    end
+  end
+
+  -- other declarations can only refer to types and enum constants
+  local types = {}
+  for i, name in ipairs(defines) do
+    types[i] = name
+  end
+  if not chunk.typedef and (not body_start or body_end < #tokens - 1) then
+    for _, name in ipairs(declarator_names(tokens, (body_end or 0) + 1, #tokens)) do
+      defines[#defines + 1] = name
+    end
+  end
+  chunk.types = types
+
+  -- references with whether they only go through a pointer
+  local references = {}
+  local own = {}
+  for _, name in ipairs(defines) do
+    own[name] = true
+  end
+  for i, token in ipairs(tokens) do
+    local key
+    if TAGS[tokens[i - 1]] and is_identifier(token) then
+      key = "tag:" .. token
+    elseif is_identifier(token) and not TAGS[token] then
+      key = token
+    end
+    if key and not own[key] then
+      local j = i + 1
+      while tokens[j] == "const" or tokens[j] == "volatile" do
+        j = j + 1
+      end
+      references[#references + 1] = {key = key, pointer = tokens[j] == "*"}
+    end
+  end
+
+  chunk.defines = defines
+  chunk.references = references
+  chunk.tag = tag
+  chunk.body_start, chunk.body_end = body_start, body_end
+end
+
+-- the declaration without its struct body, for types only used through pointers
+local function opaque_form(chunk)
+  local tokens = chunk.tokens
+  if not chunk.body_start or not chunk.tag or chunk.enum then
+    return nil
+  end
+  local out = {}
+  for i = 1, chunk.body_start - 1 do
+    out[#out + 1] = tokens[i]
+  end
+  for i = chunk.body_end + 1, #tokens do
+    out[#out + 1] = tokens[i]
+  end
+  return out
+end
+
+local function format(tokens)
+  local out = {}
+  local depth = 0
+  for i, token in ipairs(tokens) do
+    if token == "}" then
+      depth = depth - 1
+      out[#out + 1] = "\n" .. string.rep("  ", depth)
+    elseif i > 1 and not (token:match("^[,;)%]]$") or tokens[i - 1]:match("^[(%[*]$")) and
+        not (out[#out]:match("\n *$")) then
+      out[#out + 1] = " "
+    end
+    out[#out + 1] = token
+    if token == "{" then
+      depth = depth + 1
+      out[#out + 1] = "\n" .. string.rep("  ", depth)
+    elseif token == ";" and depth > 0 then
+      out[#out + 1] = "\n" .. string.rep("  ", depth)
+    end
+  end
+  return (table.concat(out):gsub(" *\n", "\n"):gsub("\n *\n", "\n"))
+end
+
+local source = assert(io.open(INPUT)):read("*a"):gsub("\n#[^\n]*", "\n"):gsub("^#[^\n]*", "")
+local chunks = split(clean(tokenize(source)))
+
+local definers, type_definers = {}, {}
+local function add(map, name, chunk)
+  map[name] = map[name] or {}
+  table.insert(map[name], chunk)
+end
+for _, chunk in ipairs(chunks) do
+  if not chunk.definition then
+    analyze(chunk)
+    for _, name in ipairs(chunk.defines) do
+      add(definers, name, chunk)
+    end
+    for _, name in ipairs(chunk.types) do
+      add(type_definers, name, chunk)
+    end
+  end
+end
+
+local OPAQUE, FULL = 1, 2
+local queue = {}
+local function need(key, level, map)
+  for _, chunk in ipairs((map or definers)[key] or {}) do
+    if (chunk.level or 0) < level then
+      chunk.level = level
+      queue[#queue + 1] = chunk
+    end
+  end
+end
+
+local roots = {}
+for _, name in ipairs(EXTRA_ROOTS) do
+  roots[name] = true
+end
+for i = 2, #arg do
+  for name in assert(io.open(arg[i])):read("*a"):gmatch("[%a_][%w_]*") do
+    if name:match("^[aA][vV]") then
+      roots[name] = true
+    end
+  end
+end
+for name in pairs(roots) do
+  need(name, FULL)
+end
+for _, name in ipairs(COMPLETE) do
+  need(name, FULL)
+  need("tag:" .. name, FULL)
+end
+
+while #queue > 0 do
+  local chunk = table.remove(queue)
+  local opaque = chunk.level == OPAQUE and opaque_form(chunk)
+  if not opaque then
+    for _, reference in ipairs(chunk.references) do
+      -- typedef struct X X; is as complete as what X is needed for
+      local level = (reference.pointer and OPAQUE) or (chunk.typedef and not chunk.body_start and chunk.level) or FULL
+      need(reference.key, level, type_definers)
+    end
+  end
+end
+
+local seen = {}
+local lines = {}
+for _, chunk in ipairs(chunks) do
+  if chunk.level then
+    local skip = false
+    for _, name in ipairs(chunk.defines) do
+      skip = skip or (chunk.typedef and BUILTIN[name])
+    end
+    local tokens = chunk.level == OPAQUE and opaque_form(chunk) or chunk.tokens
+    local text = format(tokens)
+    if not skip and not seen[text] then
+      seen[text] = true
+      lines[#lines + 1] = text
+    end
+  end
+end
+-- transmux.lua only loads the result on the platform named here, since the
+-- libc typedefs it pulls in differ between them
+local platform = source:find("__darwin_", 1, true) and "OSX" or require("ffi").os
+io.write("/* gen_cdef platform: ", platform, " */\n", table.concat(lines, "\n"), "\n")
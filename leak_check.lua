@@ -0,0 +1,60 @@
+local ffi = require 'ffi'
+local FILENAME = arg[1] or 'video.ts'
+local ITERATIONS = tonumber(arg[2]) or 100000
+local MAX_GROWTH = tonumber(arg[3]) or 4 -- MB
+local WARMUP = math.min(1000, ITERATIONS)
+
+local transmux = require("transmux")
+local callback = "int (*)(void *, uint8_t *, int)"
+
+local data = assert(io.open(FILENAME, "rb")):read("*a")
+
+-- resident set size in MB (Linux only)
+local function rss()
+  local statm = assert(io.open("/proc/self/statm"), "leak_check.lua needs /proc/self/statm")
+  local pages = statm:read("*n") and statm:read("*n")
+  statm:close()
+  return pages * 4096 / 1e6
+end
+
+-- the Lua demux path for both extract_audio and remux, into a reused output buffer
+local output = transmux.new_buffer()
+local write_function = ffi.cast(callback, function(opaque, buf, buf_size)
+  return output:write(buf, buf_size)
+end)
+
+local function run()
+  output.size = 0
+  local read_function = transmux.string_reader(data)
+  transmux.extract_audio(read_function, write_function, {input_size = #data})
+  read_function:free()
+
+  output.size = 0
+  read_function = transmux.string_reader(data)
+  transmux.remux(read_function, write_function, nil, {input_size = #data, fragmented = true})
+  read_function:free()
+end
+
+for i = 1, WARMUP do
+  run()
+end
+collectgarbage()
+local baseline = rss()
+
+for i = WARMUP + 1, ITERATIONS do
+  run()
+  if i % 10000 == 0 then
+    print(string.format("%8d iterations %8.1f MB RSS", i, rss()))
+  end
+end
+collectgarbage()
+local growth = rss() - baseline
+write_function:free()
+
+print(string.format("%s: %d iterations, RSS grew %.1f MB after warm-up (limit %.1f MB)", FILENAME, ITERATIONS,
+  growth, MAX_GROWTH))
+if growth > MAX_GROWTH then
+  print("FAIL: RSS is not flat")
+  os.exit(1)
+end
+print("OK")
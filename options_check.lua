@@ -0,0 +1,46 @@
+local FILENAME = arg[1] or 'video.ts'
+local OUT_FILENAME = os.tmpname()
+
+local transmux = require("transmux")
+if not transmux.native then
+  print("FAIL: options_check.lua needs the native shim (libtransmux.so on the library path)")
+  os.exit(1)
+end
+
+local data = assert(io.open(FILENAME, "rb")):read("*a")
+local failures = 0
+
+local function check(name, ok)
+  print(string.format("%-60s %s", name, ok and "OK" or "FAIL"))
+  if not ok then
+    failures = failures + 1
+  end
+end
+
+local function read_file(path)
+  local file = assert(io.open(path, "rb"))
+  local contents = file:read("*a")
+  file:close()
+  return contents
+end
+
+-- options the shim does not take must send the call through the Lua path
+local expected = transmux.extract_audio_from_string(data)
+check("extract_audio_from_string input_format = mpegts",
+  transmux.extract_audio_from_string(data, {input_format = "mpegts"}) == expected)
+local ok, err = pcall(transmux.extract_audio_from_string, data, {input_format = "no_such_format"})
+check("extract_audio_from_string input_format = no_such_format",
+  not ok and tostring(err):find("Unknown input format", 1, true) ~= nil)
+
+transmux.extract_audio_file(FILENAME, OUT_FILENAME, {input_format = "mpegts"})
+check("extract_audio_file input_format = mpegts", read_file(OUT_FILENAME) == expected)
+ok, err = pcall(transmux.extract_audio_file, FILENAME, OUT_FILENAME, {input_format = "no_such_format"})
+check("extract_audio_file input_format = no_such_format",
+  not ok and tostring(err):find("Unknown input format", 1, true) ~= nil)
+os.remove(OUT_FILENAME)
+
+if failures > 0 then
+  print(string.format("FAIL: %d checks failed", failures))
+  os.exit(1)
+end
+print("OK")
@@ -0,0 +1,22 @@
+-- time to ffi.cdef each header in a fresh LuaJIT state, as paid by every
+-- worker on require 'transmux'
+local LUAJIT = arg[-1] or 'luajit'
+local RUNS = tonumber(arg[1]) or 20
+local HEADERS = {'ffmpeg.h', 'ffmpeg_min.h'}
+
+local SCRIPT = "local clock = os.clock(); require('ffi').cdef(io.open('%s'):read('*a')); io.write(os.clock() - clock)"
+
+for _, header in ipairs(HEADERS) do
+  local file = io.open(header)
+  if file then
+    local size = #file:read('*a')
+    file:close()
+    local total = 0
+    for i = 1, RUNS do
+      local run = io.popen(string.format('%s -e %q', LUAJIT, SCRIPT:format(header)))
+      total = total + tonumber(run:read('*a'))
+      run:close()
+    end
+    print(string.format("%-16s %8d bytes %8.3f ms", header, size, total * 1000 / RUNS))
+  end
+end
@@ -0,0 +1,695 @@
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "libavformat/avformat.h"
+#include "transmux.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define HAVE_X86_SIMD 1
+#endif
+
+/* libavformat 58 (ffmpeg 4.0) moved stream parameters to codecpar */
+#if LIBAVFORMAT_VERSION_MAJOR >= 58
+#define STREAM_PARAMETERS(stream) ((stream)->codecpar)
+#define copy_parameters avcodec_parameters_copy
+#define packet_unref av_packet_unref
+#else
+#define STREAM_PARAMETERS(stream) ((stream)->codec)
+#define copy_parameters avcodec_copy_context
+#define packet_unref av_free_packet
+#endif
+
+#define IO_BUFFER_SIZE 8192
+#define MAX_IO_BUFFER_SIZE (8 * 1024 * 1024)
+#define ID3_TIMESTAMP_OFFSET 65
+
+typedef struct memory_reader {
+  const uint8_t *data;
+  size_t size;
+  size_t pos;
+} memory_reader;
+
+static const uint8_t id3_template[73] = {
+  /* header */
+  'I', 'D', '3',                  /* file identifier */
+  0x04, 0,                        /* version */
+  0,                              /* flags */
+  0, 0, 0, 63,                    /* size: 63 bytes */
+  /* frame */
+  'P', 'R', 'I', 'V',             /* frame id */
+  0, 0, 0, 53,                    /* frame size: 53 bytes */
+  0, 0,                           /* flags */
+  'c', 'o', 'm', '.', 'a', 'p', 'p', 'l', 'e', '.',
+  's', 't', 'r', 'e', 'a', 'm', 'i', 'n', 'g', '.',
+  't', 'r', 'a', 'n', 's', 'p', 'o', 'r', 't',
+  'S', 't', 'r', 'e', 'a', 'm',
+  'T', 'i', 'm', 'e', 's', 't', 'a', 'm', 'p',
+  0,                              /* owner terminator */
+  0, 0, 0, 0, 0, 0, 0, 0          /* timestamp */
+};
+
+static int memory_read(void *opaque, uint8_t *buf, int buf_size)
+{
+  memory_reader *reader = opaque;
+  size_t left = reader->size - reader->pos;
+  size_t delta = left < (size_t)buf_size ? left : (size_t)buf_size;
+
+  if (delta == 0)
+    return AVERROR_EOF;
+  memcpy(buf, reader->data + reader->pos, delta);
+  reader->pos += delta;
+  return (int)delta;
+}
+
+/* segments below MAX_IO_BUFFER_SIZE are read in a single callback */
+static int input_buffer_size(size_t len)
+{
+  if (len < IO_BUFFER_SIZE)
+    return IO_BUFFER_SIZE;
+  if (len > MAX_IO_BUFFER_SIZE)
+    return MAX_IO_BUFFER_SIZE;
+  return (int)len;
+}
+
+/* MPEG-TS timestamps are 33 bits; the tag carries them modulo 2^33 */
+#define PTS_MASK 0x1FFFFFFFFLL
+
+static int write_id3_header(transmux_write_cb out_cb, void *opaque, int64_t timestamp)
+{
+  uint8_t tag[sizeof(id3_template)];
+  int i;
+
+  memcpy(tag, id3_template, sizeof(tag));
+  timestamp &= PTS_MASK;
+  for (i = 0; i < 8; i++)
+    tag[ID3_TIMESTAMP_OFFSET + i] = (uint8_t)(timestamp >> (56 - 8 * i));
+  return out_cb(opaque, tag, sizeof(tag));
+}
+
+#define TS_PACKET_SIZE 188
+#define TS_SYNC_BYTE 0x47
+#define TS_STAGING_SIZE 65536
+
+enum {
+  STREAM_TYPE_PRIVATE_DATA = 0x06,
+  STREAM_TYPE_AUDIO_MPEG1 = 0x03,
+  STREAM_TYPE_AUDIO_MPEG2 = 0x04,
+  STREAM_TYPE_AUDIO_AAC = 0x0f,
+  STREAM_TYPE_AUDIO_AAC_LATM = 0x11,
+  STREAM_TYPE_AUDIO_AC3 = 0x81,
+  STREAM_TYPE_AUDIO_EAC3 = 0x87,
+  STREAM_TYPE_VIDEO_MPEG1 = 0x01,
+  STREAM_TYPE_VIDEO_MPEG2 = 0x02,
+  STREAM_TYPE_VIDEO_MPEG4 = 0x10,
+  STREAM_TYPE_VIDEO_H264 = 0x1b,
+  STREAM_TYPE_VIDEO_HEVC = 0x24
+};
+
+typedef struct ts_scan {
+  const uint8_t *in;
+  const uint16_t *pids;
+  size_t packets;
+  int pmt_pid;
+  int audio_pid;
+  int64_t first_pts;
+  size_t first_packet;
+} ts_scan;
+
+typedef struct ts_output {
+  transmux_write_cb out_cb;
+  void *opaque;
+  uint8_t staging[TS_STAGING_SIZE];
+  int size;
+} ts_output;
+
+static int ts_pid(const uint8_t *packet)
+{
+  return ((packet[1] & 0x1f) << 8) | packet[2];
+}
+
+#ifdef HAVE_X86_SIMD
+static uint32_t ts_header(const uint8_t *packet)
+{
+  uint32_t header;
+
+  memcpy(&header, packet, sizeof(header));
+  return header;
+}
+
+/* 4 packets per iteration, headers loaded one by one */
+static ptrdiff_t ts_classify_sse2(const uint8_t *in, size_t packets, uint16_t *pids)
+{
+  const __m128i sync = _mm_set1_epi32(TS_SYNC_BYTE);
+  const __m128i low_byte = _mm_set1_epi32(0xff);
+  const __m128i pid_high = _mm_set1_epi32(0x1f);
+  size_t n;
+
+  for (n = 0; n + 4 <= packets; n += 4) {
+    const uint8_t *packet = in + n * TS_PACKET_SIZE;
+    __m128i headers = _mm_set_epi32(ts_header(packet + 3 * TS_PACKET_SIZE), ts_header(packet + 2 * TS_PACKET_SIZE),
+                                    ts_header(packet + TS_PACKET_SIZE), ts_header(packet));
+    __m128i pid;
+
+    if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(headers, low_byte), sync)) != 0xffff)
+      return -1;
+    pid = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(headers, 8), pid_high), 8),
+                       _mm_and_si128(_mm_srli_epi32(headers, 16), low_byte));
+    _mm_storel_epi64((__m128i *)(pids + n), _mm_packs_epi32(pid, pid));
+  }
+  return n;
+}
+
+/* 8 packets per iteration, headers fetched with a single gather */
+__attribute__((target("avx2")))
+static ptrdiff_t ts_classify_avx2(const uint8_t *in, size_t packets, uint16_t *pids)
+{
+  const __m256i offsets = _mm256_setr_epi32(0, TS_PACKET_SIZE, 2 * TS_PACKET_SIZE, 3 * TS_PACKET_SIZE,
+                                            4 * TS_PACKET_SIZE, 5 * TS_PACKET_SIZE, 6 * TS_PACKET_SIZE,
+                                            7 * TS_PACKET_SIZE);
+  const __m256i sync = _mm256_set1_epi32(TS_SYNC_BYTE);
+  const __m256i low_byte = _mm256_set1_epi32(0xff);
+  const __m256i pid_high = _mm256_set1_epi32(0x1f);
+  size_t n;
+
+  for (n = 0; n + 8 <= packets; n += 8) {
+    __m256i headers = _mm256_i32gather_epi32((const int *)(in + n * TS_PACKET_SIZE), offsets, 1);
+    __m256i pid;
+
+    if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(headers, low_byte), sync)) != -1)
+      return -1;
+    pid = _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(_mm256_srli_epi32(headers, 8), pid_high), 8),
+                          _mm256_and_si256(_mm256_srli_epi32(headers, 16), low_byte));
+    /* packus works per 128-bit lane, gather the two low quadwords back */
+    pid = _mm256_permute4x64_epi64(_mm256_packus_epi32(pid, pid), 0x08);
+    _mm_storeu_si128((__m128i *)(pids + n), _mm256_castsi256_si128(pid));
+  }
+  return n;
+}
+#endif
+
+ptrdiff_t transmux_ts_classify(const uint8_t *in, size_t len, uint16_t *pids)
+{
+  size_t packets = len / TS_PACKET_SIZE;
+  ptrdiff_t n = 0;
+
+#ifdef HAVE_X86_SIMD
+  n = __builtin_cpu_supports("avx2") ? ts_classify_avx2(in, packets, pids) : ts_classify_sse2(in, packets, pids);
+  if (n < 0)
+    return -1;
+#endif
+  for (; (size_t)n < packets; n++) {
+    const uint8_t *packet = in + n * TS_PACKET_SIZE;
+
+    if (packet[0] != TS_SYNC_BYTE)
+      return -1;
+    pids[n] = ts_pid(packet);
+  }
+  return packets;
+}
+
+/* returns the payload offset, or -1 if the packet carries none */
+static int ts_payload_offset(const uint8_t *packet)
+{
+  int adaptation_field_control = (packet[3] >> 4) & 3;
+  int offset = 4;
+
+  if (!(adaptation_field_control & 1))
+    return -1;
+  if (adaptation_field_control & 2)
+    offset += 1 + packet[4];
+  return offset < TS_PACKET_SIZE ? offset : -1;
+}
+
+/* returns the section following the pointer field if it fits this packet */
+static const uint8_t *ts_section(const uint8_t *packet, int table_id, int *section_length)
+{
+  int offset = ts_payload_offset(packet);
+  const uint8_t *section;
+
+  if (offset < 0 || !(packet[1] & 0x40))
+    return NULL;
+  offset += 1 + packet[offset];
+  if (offset + 3 > TS_PACKET_SIZE)
+    return NULL;
+  section = packet + offset;
+  *section_length = ((section[1] & 0x0f) << 8) | section[2];
+  if (section[0] != table_id || offset + 3 + *section_length > TS_PACKET_SIZE || *section_length < 9)
+    return NULL;
+  return section;
+}
+
+static int ts_parse_pat(ts_scan *scan, const uint8_t *packet)
+{
+  int section_length, i;
+  const uint8_t *section = ts_section(packet, 0x00, &section_length);
+
+  if (!section)
+    return TRANSMUX_UNSUPPORTED;
+  /* entries run from after the 8 byte header up to the CRC */
+  for (i = 8; i + 4 <= 3 + section_length - 4; i += 4) {
+    int program_number = (section[i] << 8) | section[i + 1];
+    int pid = ((section[i + 2] & 0x1f) << 8) | section[i + 3];
+    if (program_number == 0)
+      continue;
+    if (scan->pmt_pid >= 0 && scan->pmt_pid != pid)
+      return TRANSMUX_UNSUPPORTED; /* several programs, let av_find_best_stream pick */
+    scan->pmt_pid = pid;
+  }
+  return scan->pmt_pid >= 0 ? 0 : TRANSMUX_UNSUPPORTED;
+}
+
+static int ts_parse_pmt(ts_scan *scan, const uint8_t *packet)
+{
+  int section_length, i, end;
+  const uint8_t *section = ts_section(packet, 0x02, &section_length);
+  int audio_pid = -1;
+
+  if (!section)
+    return TRANSMUX_UNSUPPORTED;
+  end = 3 + section_length - 4;
+  i = 12 + (((section[10] & 0x0f) << 8) | section[11]);
+  for (; i + 5 <= end; i += 5 + (((section[i + 3] & 0x0f) << 8) | section[i + 4])) {
+    int pid = ((section[i + 1] & 0x1f) << 8) | section[i + 2];
+    switch (section[i]) {
+    case STREAM_TYPE_AUDIO_AAC:
+      if (audio_pid >= 0)
+        return TRANSMUX_UNSUPPORTED;
+      audio_pid = pid;
+      break;
+    case STREAM_TYPE_PRIVATE_DATA:
+    case STREAM_TYPE_AUDIO_MPEG1:
+    case STREAM_TYPE_AUDIO_MPEG2:
+    case STREAM_TYPE_AUDIO_AAC_LATM:
+    case STREAM_TYPE_AUDIO_AC3:
+    case STREAM_TYPE_AUDIO_EAC3:
+      return TRANSMUX_UNSUPPORTED;
+    }
+  }
+  if (audio_pid < 0 || (scan->audio_pid >= 0 && scan->audio_pid != audio_pid))
+    return TRANSMUX_UNSUPPORTED;
+  scan->audio_pid = audio_pid;
+  return 0;
+}
+
+/* returns the offset of the PES payload, reading the PTS into *pts */
+static int ts_parse_pes_header(const uint8_t *packet, int offset, int64_t *pts)
+{
+  const uint8_t *pes = packet + offset;
+  int header_end;
+
+  if (offset + 9 > TS_PACKET_SIZE || pes[0] || pes[1] || pes[2] != 1 || (pes[3] & 0xe0) != 0xc0)
+    return -1;
+  header_end = offset + 9 + pes[8];
+  if (header_end > TS_PACKET_SIZE)
+    return -1;
+  *pts = AV_NOPTS_VALUE;
+  if (pes[7] & 0x80) {
+    if (pes[8] < 5)
+      return -1;
+    *pts = ((int64_t)(pes[9] & 0x0e) << 29) | (pes[10] << 22) | ((pes[11] & 0xfe) << 14) |
+           (pes[12] << 7) | (pes[13] >> 1);
+  }
+  return header_end;
+}
+
+/*
+ * Validates the whole segment before anything is written, so that
+ * unusual inputs can still go through libavformat.
+ */
+static int ts_scan_segment(ts_scan *scan)
+{
+  int continuity = -1;
+  size_t n;
+
+  for (n = 0; n < scan->packets; n++) {
+    const uint8_t *packet = scan->in + n * TS_PACKET_SIZE;
+    int pid = scan->pids[n];
+    int offset;
+
+    if (pid != 0 && pid != scan->pmt_pid && pid != scan->audio_pid)
+      continue;
+    if ((packet[1] & 0x80) || (packet[3] & 0xc0))
+      return TRANSMUX_UNSUPPORTED; /* transport error or scrambling */
+    if (pid == 0) {
+      if (ts_parse_pat(scan, packet))
+        return TRANSMUX_UNSUPPORTED;
+    } else if (pid == scan->pmt_pid) {
+      if (ts_parse_pmt(scan, packet))
+        return TRANSMUX_UNSUPPORTED;
+    } else if (pid == scan->audio_pid && (offset = ts_payload_offset(packet)) >= 0) {
+      int counter = packet[3] & 0x0f;
+
+      if (continuity >= 0 && counter != ((continuity + 1) & 0x0f) && counter != continuity)
+        return TRANSMUX_UNSUPPORTED;
+      continuity = counter;
+      if (packet[1] & 0x40) {
+        int64_t pts;
+        int payload = ts_parse_pes_header(packet, offset, &pts);
+
+        if (payload < 0)
+          return TRANSMUX_UNSUPPORTED;
+        if (scan->first_pts == AV_NOPTS_VALUE) {
+          /* the payload must start with an ADTS frame */
+          if (pts == AV_NOPTS_VALUE || payload + 2 > TS_PACKET_SIZE ||
+              packet[payload] != 0xff || (packet[payload + 1] & 0xf6) != 0xf0)
+            return TRANSMUX_UNSUPPORTED;
+          scan->first_pts = pts;
+          scan->first_packet = n;
+        }
+      }
+    }
+  }
+  return scan->first_pts != AV_NOPTS_VALUE ? 0 : TRANSMUX_UNSUPPORTED;
+}
+
+static int ts_output_write(ts_output *output, const uint8_t *data, int size)
+{
+  if (output->size + size > TS_STAGING_SIZE) {
+    int ret = output->out_cb(output->opaque, output->staging, output->size);
+    if (ret < 0)
+      return ret;
+    output->size = 0;
+  }
+  memcpy(output->staging + output->size, data, size);
+  output->size += size;
+  return 0;
+}
+
+static int ts_extract_audio(const uint8_t *in, size_t len, const uint16_t *pids,
+                            transmux_write_cb out_cb, void *opaque)
+{
+  ts_scan scan = { in, pids, len / TS_PACKET_SIZE, -1, -1, AV_NOPTS_VALUE, 0 };
+  ts_output *output;
+  int continuity = -1;
+  int ret;
+  size_t n;
+
+  if (ts_scan_segment(&scan))
+    return TRANSMUX_UNSUPPORTED;
+
+  output = av_malloc(sizeof(*output));
+  if (!output)
+    return AVERROR(ENOMEM);
+  output->out_cb = out_cb;
+  output->opaque = opaque;
+  output->size = 0;
+
+  if ((ret = write_id3_header(out_cb, opaque, scan.first_pts)) < 0)
+    goto end;
+
+  /* like the demuxer, drop the tail of a PES started before the segment */
+  for (n = scan.first_packet; n < scan.packets; n++) {
+    const uint8_t *packet = in + n * TS_PACKET_SIZE;
+    int offset;
+
+    if (pids[n] != scan.audio_pid || (offset = ts_payload_offset(packet)) < 0)
+      continue;
+    /* a repeated continuity counter marks a duplicate of the previous packet */
+    if ((packet[3] & 0x0f) == continuity)
+      continue;
+    continuity = packet[3] & 0x0f;
+    if (packet[1] & 0x40) {
+      int64_t pts;
+      offset = ts_parse_pes_header(packet, offset, &pts);
+    }
+    if ((ret = ts_output_write(output, packet + offset, TS_PACKET_SIZE - offset)) < 0)
+      goto end;
+  }
+  ret = output->size ? out_cb(opaque, output->staging, output->size) : 0;
+
+end:
+  av_free(output);
+  return ret < 0 ? ret : 0;
+}
+
+/*
+ * Copies the packets libavformat needs to demux the audio, leaving out the
+ * video PIDs announced in the PMTs. Returns NULL when nothing was dropped.
+ */
+static uint8_t *ts_prefilter(const uint8_t *in, size_t packets, const uint16_t *pids, size_t *filtered_len)
+{
+  enum { PID_KEEP, PID_PMT, PID_DROP };
+  uint8_t *kind = av_mallocz(8192);
+  uint8_t *filtered = NULL;
+  size_t n, dropped = 0;
+
+  if (!kind)
+    return NULL;
+  for (n = 0; n < packets; n++) {
+    const uint8_t *packet = in + n * TS_PACKET_SIZE;
+    const uint8_t *section;
+    int section_length, i, end;
+
+    if (pids[n] == 0 && (section = ts_section(packet, 0x00, &section_length))) {
+      for (i = 8; i + 4 <= 3 + section_length - 4; i += 4)
+        if ((section[i] << 8) | section[i + 1])
+          kind[((section[i + 2] & 0x1f) << 8) | section[i + 3]] = PID_PMT;
+    } else if (kind[pids[n]] == PID_PMT && (section = ts_section(packet, 0x02, &section_length))) {
+      end = 3 + section_length - 4;
+      i = 12 + (((section[10] & 0x0f) << 8) | section[11]);
+      for (; i + 5 <= end; i += 5 + (((section[i + 3] & 0x0f) << 8) | section[i + 4])) {
+        switch (section[i]) {
+        case STREAM_TYPE_VIDEO_MPEG1:
+        case STREAM_TYPE_VIDEO_MPEG2:
+        case STREAM_TYPE_VIDEO_MPEG4:
+        case STREAM_TYPE_VIDEO_H264:
+        case STREAM_TYPE_VIDEO_HEVC:
+          kind[((section[i + 1] & 0x1f) << 8) | section[i + 2]] = PID_DROP;
+        }
+      }
+    } else if (kind[pids[n]] == PID_DROP) {
+      dropped++;
+    }
+  }
+
+  if (dropped && (filtered = av_malloc((packets - dropped) * TS_PACKET_SIZE))) {
+    *filtered_len = 0;
+    for (n = 0; n < packets; n++) {
+      if (kind[pids[n]] == PID_DROP)
+        continue;
+      memcpy(filtered + *filtered_len, in + n * TS_PACKET_SIZE, TS_PACKET_SIZE);
+      *filtered_len += TS_PACKET_SIZE;
+    }
+  }
+  av_free(kind);
+  return filtered;
+}
+
+int transmux_extract_audio_ts(const uint8_t *in, size_t len, transmux_write_cb out_cb, void *opaque)
+{
+  uint16_t *pids;
+  int ret = TRANSMUX_UNSUPPORTED;
+
+  if (len % TS_PACKET_SIZE)
+    return TRANSMUX_UNSUPPORTED;
+  pids = av_malloc((len / TS_PACKET_SIZE) * sizeof(*pids));
+  if (!pids)
+    return AVERROR(ENOMEM);
+  if (transmux_ts_classify(in, len, pids) >= 0)
+    ret = ts_extract_audio(in, len, pids, out_cb, opaque);
+  av_free(pids);
+  return ret;
+}
+
+uint8_t *transmux_ts_audio_only(const uint8_t *in, size_t len, size_t *filtered_len)
+{
+  uint16_t *pids;
+  uint8_t *filtered = NULL;
+
+  if (len % TS_PACKET_SIZE)
+    return NULL;
+  pids = av_malloc((len / TS_PACKET_SIZE) * sizeof(*pids));
+  if (!pids)
+    return NULL;
+  if (transmux_ts_classify(in, len, pids) >= 0)
+    filtered = ts_prefilter(in, len / TS_PACKET_SIZE, pids, filtered_len);
+  av_free(pids);
+  return filtered;
+}
+
+int transmux_extract_audio(const uint8_t *in, size_t len, transmux_write_cb out_cb, void *opaque)
+{
+  memory_reader reader = { in, len, 0 };
+  AVFormatContext *input_context = NULL;
+  AVFormatContext *output_context = NULL;
+  AVIOContext *input_io = NULL;
+  AVIOContext *output_io = NULL;
+  AVStream *output_stream;
+  uint8_t *buffer;
+  int buffer_size = input_buffer_size(len);
+  AVPacket packet;
+  int audio_stream_id;
+  unsigned i;
+  int first_packet = 1;
+  uint8_t *filtered = NULL;
+  int ret;
+
+  if (len % TS_PACKET_SIZE == 0) {
+    uint16_t *pids = av_malloc((len / TS_PACKET_SIZE) * sizeof(*pids));
+
+    if (!pids)
+      return AVERROR(ENOMEM);
+    if (transmux_ts_classify(in, len, pids) >= 0) {
+      ret = ts_extract_audio(in, len, pids, out_cb, opaque);
+      if (ret != TRANSMUX_UNSUPPORTED) {
+        av_free(pids);
+        return ret;
+      }
+      /* libavformat only gets to see what the audio needs */
+      filtered = ts_prefilter(in, len / TS_PACKET_SIZE, pids, &reader.size);
+      if (filtered)
+        reader.data = filtered;
+    }
+    av_free(pids);
+  }
+
+#if LIBAVFORMAT_VERSION_MAJOR < 58
+  av_register_all();
+#endif
+
+  buffer = av_malloc(buffer_size);
+  if (!buffer) {
+    av_free(filtered);
+    return AVERROR(ENOMEM);
+  }
+  input_io = avio_alloc_context(buffer, buffer_size, 0, &reader, memory_read, NULL, NULL);
+  if (!input_io) {
+    av_free(buffer);
+    av_free(filtered);
+    return AVERROR(ENOMEM);
+  }
+
+  input_context = avformat_alloc_context();
+  if (!input_context) {
+    ret = AVERROR(ENOMEM);
+    goto end;
+  }
+  input_context->pb = input_io;
+
+  if ((ret = avformat_open_input(&input_context, "dummy", NULL, NULL)) < 0)
+    goto end;
+  if ((ret = avformat_find_stream_info(input_context, NULL)) < 0)
+    goto end;
+  if ((ret = av_find_best_stream(input_context, AVMEDIA_TYPE_AUDIO, -1, -1, NULL, 0)) < 0)
+    goto end;
+  audio_stream_id = ret;
+  /* let the demuxer skip payload reassembly for everything but the audio */
+  for (i = 0; i < input_context->nb_streams; i++)
+    if (i != (unsigned)audio_stream_id)
+      input_context->streams[i]->discard = AVDISCARD_ALL;
+
+  output_context = avformat_alloc_context();
+  if (!output_context) {
+    ret = AVERROR(ENOMEM);
+    goto end;
+  }
+  output_stream = avformat_new_stream(output_context, NULL);
+  buffer = av_malloc(IO_BUFFER_SIZE);
+  if (buffer)
+    output_io = avio_alloc_context(buffer, IO_BUFFER_SIZE, 1, opaque, NULL, out_cb, NULL);
+  if (!output_stream || !output_io) {
+    if (!output_io)
+      av_free(buffer);
+    ret = AVERROR(ENOMEM);
+    goto end;
+  }
+  output_context->pb = output_io;
+  output_context->oformat = av_guess_format("adts", NULL, NULL);
+
+  if ((ret = copy_parameters(STREAM_PARAMETERS(output_stream),
+                             STREAM_PARAMETERS(input_context->streams[audio_stream_id]))) < 0)
+    goto end;
+  if ((ret = avformat_write_header(output_context, NULL)) < 0)
+    goto end;
+
+  av_init_packet(&packet);
+  while (av_read_frame(input_context, &packet) >= 0) {
+    if (packet.stream_index == audio_stream_id) {
+      ret = 0;
+      /* without a timestamp on the first packet there is nothing to tag */
+      if (first_packet && packet.pts != AV_NOPTS_VALUE) {
+        /* the tag must precede any ADTS data still buffered in output_io */
+        avio_flush(output_io);
+        ret = write_id3_header(out_cb, opaque, packet.pts);
+      }
+      first_packet = 0;
+      packet.stream_index = 0;
+      /* a single output stream needs no interleave queue */
+      if (ret >= 0)
+        ret = av_write_frame(output_context, &packet);
+    }
+    packet_unref(&packet);
+    if (ret < 0)
+      goto end;
+  }
+
+  if ((ret = av_write_frame(output_context, NULL)) < 0)
+    goto end;
+  avio_flush(output_io);
+  ret = av_write_trailer(output_context);
+
+end:
+  if (output_context) {
+    avformat_free_context(output_context);
+  }
+  if (output_io) {
+    av_freep(&output_io->buffer);
+    av_free(output_io);
+  }
+  avformat_close_input(&input_context);
+  if (input_io) {
+    av_freep(&input_io->buffer);
+    av_free(input_io);
+  }
+  av_free(filtered);
+  return ret < 0 ? ret : 0;
+}
+
+int transmux_buffer_write(void *opaque, uint8_t *buf, int buf_size)
+{
+  transmux_buffer *buffer = opaque;
+
+  if (buffer->size + buf_size > buffer->capacity) {
+    size_t capacity = buffer->capacity ? buffer->capacity : IO_BUFFER_SIZE;
+    uint8_t *data;
+
+    while (capacity < buffer->size + buf_size)
+      capacity *= 2;
+    data = realloc(buffer->data, capacity);
+    if (!data)
+      return AVERROR(ENOMEM);
+    buffer->data = data;
+    buffer->capacity = capacity;
+  }
+  memcpy(buffer->data + buffer->size, buf, buf_size);
+  buffer->size += buf_size;
+  return buf_size;
+}
+
+void transmux_buffer_free(transmux_buffer *buffer)
+{
+  free(buffer->data);
+  buffer->data = NULL;
+  buffer->size = 0;
+  buffer->capacity = 0;
+}
+
+int transmux_fd_write(void *opaque, uint8_t *buf, int buf_size)
+{
+  int fd = *(int *)opaque;
+  int written = 0;
+
+  while (written < buf_size) {
+    ssize_t ret = write(fd, buf + written, buf_size - written);
+    if (ret < 0) {
+      if (errno == EINTR)
+        continue;
+      return AVERROR(errno);
+    }
+    written += ret;
+  }
+  return buf_size;
+}
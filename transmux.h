@@ -0,0 +1,54 @@
+#ifndef TRANSMUX_H
+#define TRANSMUX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Same signature as the AVIO write callbacks used by transmux.lua */
+typedef int (*transmux_write_cb)(void *opaque, uint8_t *buf, int buf_size);
+
+/* Growable output buffer, usable as opaque for transmux_buffer_write */
+typedef struct transmux_buffer {
+  uint8_t *data;
+  size_t size;
+  size_t capacity;
+} transmux_buffer;
+
+/*
+ * Extracts the best audio stream of an in-memory segment into ADTS,
+ * prefixed by the HLS ID3 timestamp tag. Returns 0 or a negative AVERROR.
+ */
+int transmux_extract_audio(const uint8_t *in, size_t len, transmux_write_cb out_cb, void *opaque);
+
+enum { TRANSMUX_UNSUPPORTED = 1 };
+
+/*
+ * Fast path for MPEG-TS with a single ADTS AAC stream: follows the audio
+ * PID and writes the PES payloads as is, without libavformat. Returns
+ * TRANSMUX_UNSUPPORTED, before writing anything, for any other input.
+ * transmux_extract_audio tries it first.
+ */
+int transmux_extract_audio_ts(const uint8_t *in, size_t len, transmux_write_cb out_cb, void *opaque);
+
+/*
+ * Checks the sync byte of every 188-byte packet and stores its PID in pids
+ * (len / 188 entries), using SSE2/AVX2 where available. Returns the number
+ * of packets, or -1 if any packet is out of sync.
+ */
+ptrdiff_t transmux_ts_classify(const uint8_t *in, size_t len, uint16_t *pids);
+
+/*
+ * Copies a TS input without the packets of the video PIDs announced in its
+ * PMTs, for demuxing its audio only. Returns the copy, to be freed with
+ * av_free, with its size in *filtered_len, or NULL when the input is not
+ * TS or nothing would be dropped.
+ */
+uint8_t *transmux_ts_audio_only(const uint8_t *in, size_t len, size_t *filtered_len);
+
+int transmux_buffer_write(void *opaque, uint8_t *buf, int buf_size);
+void transmux_buffer_free(transmux_buffer *buffer);
+
+/* Writes to the file descriptor pointed to by opaque (an int *) */
+int transmux_fd_write(void *opaque, uint8_t *buf, int buf_size);
+
+#endif
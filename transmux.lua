@@ -2,19 +2,106 @@ local M = {}
 local ffi = require 'ffi'
 local avformat = ffi.load('avformat')
 local avutil = ffi.load('avutil')
-local header = assert(io.open('ffmpeg.h')):read('*a')
+local native_header = assert(io.open('transmux.h')):read('*a')
 local AV_LOG_FATAL = 8
 local AVFMT_GLOBALHEADER = 64
+local AVFMT_FLAG_FLUSH_PACKETS = 0x0200
 local AV_ROUND_NEAR_INF = 5
 local AV_ROUND_PASS_MINMAX = 8192
 local AV_PKT_FLAG_KEY = 1
+local AV_TIME_BASE = 1000000
+local AV_NOPTS_VALUE = ffi.cast("int64_t", 0x8000000000000000ULL)
+local INT64_MIN = AV_NOPTS_VALUE
+local AVSEEK_FLAG_BYTE = 2
+local AVSEEK_SIZE = 0x10000
+local AVSEEK_FORCE = 0x20000
+local AVERROR_STREAM_NOT_FOUND = -0x525453F8 -- FFERRTAG(0xF8,'S','T','R')
+local TS_PACKET_SIZE = 188
 
 local CODEC_FLAG_GLOBAL_HEADER = 4194304 -- 0x00400000
 
 local callback = "int (*)(void *, uint8_t *, int)"
-ffi.cdef(header)
+local seek_callback = "int64_t (*)(void *, int64_t, int)"
 
-avformat.av_register_all()
+-- struct layouts change with every libavformat major version, so the header
+-- is picked by the version of the library actually loaded. The lookup goes
+-- through an alias so that the header can still declare avformat_version.
+ffi.cdef[[
+unsigned transmux_avformat_version(void) __asm__("avformat_version");
+]]
+local AVFORMAT_MAJOR = bit.rshift(avformat.transmux_avformat_version(), 16)
+M.avformat_major = AVFORMAT_MAJOR
+
+-- ffmpeg.h and ffmpeg_min.h describe ffmpeg 2.3 (libavformat 55); headers
+-- for other versions are named after their major, e.g. ffmpeg58_min.h
+local BUNDLED_AVFORMAT_MAJOR = 55
+
+local function find_header(major)
+  -- the minimal cdef made by gen_cdef.lua parses much faster than the full header
+  local names = {"ffmpeg" .. major .. "_min.h", "ffmpeg" .. major .. ".h"}
+  if major == BUNDLED_AVFORMAT_MAJOR then
+    names[#names + 1] = "ffmpeg_min.h"
+    names[#names + 1] = "ffmpeg.h"
+  end
+  for _, name in ipairs(names) do
+    local file = io.open(name)
+    if file then
+      local header = file:read('*a')
+      file:close()
+      -- a minimal header is only used on the platform it was generated on
+      local minimal = name:find("_min.h", 1, true)
+      if not minimal or header:match("^/%* gen_cdef platform: (%w+) %*/") == ffi.os then
+        return header
+      end
+    end
+  end
+  error(string.format("No ffmpeg header for libavformat %d, generate %s (see README)", major, names[1]))
+end
+
+ffi.cdef(find_header(AVFORMAT_MAJOR))
+ffi.cdef((native_header:gsub('#[^\n]*', '')))
+
+ffi.cdef[[
+typedef struct {
+  int64_t pts;
+  int64_t pos;
+  int32_t stream_index;
+  int32_t flags;
+} transmux_index_entry;
+
+typedef struct {
+  char magic[4];
+  uint32_t version;
+  uint32_t count;
+  int32_t video_stream;
+} transmux_index_header;
+]]
+
+ffi.cdef[[
+int open(const char *path, int flags, ...);
+int close(int fd);
+off_t lseek(int fd, off_t offset, int whence);
+ssize_t write(int fd, const void *buf, size_t count);
+void *mmap(void *addr, size_t length, int prot, int flags, int fd, off_t offset);
+int munmap(void *addr, size_t length);
+int madvise(void *addr, size_t length, int advice);
+]]
+local O_RDONLY = 0
+local O_WRONLY_CREAT_TRUNC = ffi.os == "OSX" and 0x601 or 0x241
+local SEEK_CUR = 1
+local SEEK_END = 2
+local PROT_READ = 1
+local MAP_PRIVATE = 2
+local MADV_SEQUENTIAL = 2
+local MAP_FAILED = ffi.cast("void *", -1)
+local EINTR = 4
+
+-- optional C shim (transmux.c), runs the whole demux/mux loop natively
+local has_native, native = pcall(ffi.load, 'transmux')
+if not has_native then
+  native = nil
+end
+M.native = native
 
 local function av_assert(err)
   if err < 0 then
@@ -29,182 +116,1518 @@ local function av_assert(err)
   return err
 end
 
-local id3_timestamp_representation = function(timestamp)
-  local hex_timestamp = string.format("%016x", timestamp)
-  local chars = {}
-  for i = 1, 16, 2 do
-    local byte = tonumber(string.sub(hex_timestamp, i, i + 1), 16)
-    chars[#chars + 1] = string.char(byte)
+-- API differences between ffmpeg 2.x and 4.0+ (libavformat 58), where
+-- AVStream.codec gave way to codecpar and packets became refcounted only
+local compat
+if AVFORMAT_MAJOR >= 58 then
+  local function free_parameters(parameters)
+    avformat.avcodec_parameters_free(ffi.new("AVCodecParameters*[1]", parameters))
   end
-  return table.concat(chars)
+  local function free_packet(packet)
+    avformat.av_packet_free(ffi.new("AVPacket*[1]", packet))
+  end
+  compat = {
+    parameters = function(stream) return stream.codecpar end,
+    alloc_parameters = function() return ffi.gc(avformat.avcodec_parameters_alloc(), free_parameters) end,
+    copy_parameters = function(dst, src) return avformat.avcodec_parameters_copy(dst, src) end,
+    stream_codec = function(stream) return nil end,
+    set_global_header = function(stream) end,
+    find_stream_info = function(input_context) return avformat.avformat_find_stream_info(input_context, nil) end,
+    new_packet = function() return ffi.gc(avformat.av_packet_alloc(), free_packet) end,
+    init_packet = function(packet) end,
+    packet_unref = function(packet) avformat.av_packet_unref(packet) end,
+    make_refcounted = function(packet)
+      if packet.buf == nil then
+        av_assert(avformat.av_packet_make_refcounted(packet))
+      end
+    end,
+    max_analyze_duration = "max_analyze_duration",
+  }
+else
+  local function free_codec_context(codec)
+    avformat.avcodec_free_context(ffi.new("AVCodecContext*[1]", codec))
+  end
+  compat = {
+    parameters = function(stream) return stream.codec end,
+    alloc_parameters = function() return ffi.gc(avformat.avcodec_alloc_context3(nil), free_codec_context) end,
+    copy_parameters = function(dst, src) return avformat.avcodec_copy_context(dst, src) end,
+    stream_codec = function(stream) return stream.codec.codec end,
+    set_global_header = function(stream)
+      stream.codec.flags = bit.bor(stream.codec.flags, CODEC_FLAG_GLOBAL_HEADER)
+    end,
+    find_stream_info = function(input_context) return avformat.av_find_stream_info(input_context) end,
+    new_packet = function() return ffi.new("AVPacket") end,
+    init_packet = function(packet) avformat.av_init_packet(packet) end,
+    packet_unref = function(packet) avformat.av_free_packet(packet) end,
+    make_refcounted = function(packet)
+      if packet.buf == nil then
+        av_assert(avformat.av_dup_packet(packet))
+      end
+    end,
+    max_analyze_duration = "max_analyze_duration2",
+  }
+  avformat.av_register_all()
 end
 
+local ID3_OWNER = "com.apple.streaming.transportStreamTimestamp"
+local ID3_TAG_SIZE = 73
+local ID3_TIMESTAMP_OFFSET = ID3_TAG_SIZE - 8
+
+-- only the timestamp changes between tags, so one buffer is patched in place
+local id3_tag = ffi.new("uint8_t[?]", ID3_TAG_SIZE, table.concat({
+  -- header
+  "ID3",                          -- file identifier
+  string.char(0x04, 0),           -- version
+  string.char(0),                 -- flags
+  string.char(0, 0, 0, 63),       -- size: 63 bytes
+  -- frame
+  "PRIV",                         -- frame id
+  string.char(0, 0, 0, 53),       -- frame size: 53 bytes
+  string.char(0, 0),              -- flags
+  ID3_OWNER,                      -- owner
+  string.char(0),                 -- owner terminator
+}))
+
+-- MPEG-TS timestamps are 33 bits wide and the tag holds them modulo 2^33
+local PTS_MODULO = 0x200000000ULL
+
+-- the tag and its size, valid until the next call; timestamp is an int64
+-- pts, masked as such so that it never goes through a double unwrapped
 local id3_header = function(timestamp)
-  local OWNER = "com.apple.streaming.transportStreamTimestamp"
-  local buffer = {
-    -- header
-    "ID3",                          -- file identifier
-    string.char(0x04, 0),           -- version
-    string.char(0),                 -- flags
-    string.char(0, 0, 0, 63),       -- size: 63 bytes
-    -- frame
-    "PRIV",                         -- frame id
-    string.char(0, 0, 0, 53),       -- frame size: 53 bytes
-    string.char(0, 0),              -- flags
-    OWNER,                          -- owner
-    string.char(0),                 -- owner terminator
-    id3_timestamp_representation(timestamp)
-  }
-  return table.concat(buffer)
+  timestamp = tonumber(ffi.cast("uint64_t", timestamp) % PTS_MODULO)
+  for i = ID3_TAG_SIZE - 1, ID3_TIMESTAMP_OFFSET, -1 do
+    id3_tag[i] = timestamp % 256
+    timestamp = math.floor(timestamp / 256)
+  end
+  return id3_tag, ID3_TAG_SIZE
+end
+
+-- growable malloc'ed output buffer, avoids interning every chunk as a string
+local Buffer = {}
+Buffer.__index = Buffer
+
+local function new_buffer(capacity)
+  local self = setmetatable({size = 0, capacity = 0}, Buffer)
+  self:reserve(capacity or 8192)
+  return self
+end
+M.new_buffer = new_buffer
+
+function Buffer:reserve(capacity)
+  if capacity <= self.capacity then
+    return
+  end
+  local data = ffi.C.realloc(self.data, capacity)
+  if data == nil then
+    error("Failed allocating output buffer")
+  end
+  -- the old block is only gone once realloc succeeded
+  if self.data then
+    ffi.gc(self.data, nil)
+  end
+  self.data = ffi.gc(ffi.cast("uint8_t *", data), ffi.C.free)
+  self.capacity = capacity
+end
+
+function Buffer:write(buf, buf_size)
+  local size = self.size + buf_size
+  if size > self.capacity then
+    self:reserve(math.max(size, self.capacity * 2))
+  end
+  ffi.copy(self.data + self.size, buf, buf_size)
+  self.size = size
+  return buf_size
+end
+
+function Buffer:tostring()
+  if self.size == 0 then
+    return ""
+  end
+  return ffi.string(self.data, self.size)
+end
+
+-- expected ADTS size, from the audio bitrate and the input share or duration
+local function estimate_output_size(input_context, audio_codec, input_size)
+  -- bit rates are int64 from libavformat 58 on
+  local audio_bit_rate = tonumber(audio_codec.bit_rate)
+  local input_bit_rate = tonumber(input_context.bit_rate)
+  if audio_bit_rate <= 0 then
+    return nil
+  end
+  if input_size and input_bit_rate > 0 then
+    return math.ceil(input_size * audio_bit_rate / input_bit_rate)
+  end
+  local duration = tonumber(input_context.duration)
+  if duration > 0 then
+    return math.ceil(audio_bit_rate / 8 * duration / AV_TIME_BASE)
+  end
+  return nil
+end
+
+local DEFAULT_BUFFER_SIZE = 8192
+local MAX_BUFFER_SIZE = 8 * 1024 * 1024
+
+-- segments below MAX_BUFFER_SIZE are read in a single callback
+local function input_buffer_size(options)
+  if options.read_buffer_size then
+    return options.read_buffer_size
+  end
+  if not options.input_size then
+    return DEFAULT_BUFFER_SIZE
+  end
+  return math.min(math.max(options.input_size, DEFAULT_BUFFER_SIZE), MAX_BUFFER_SIZE)
+end
+
+local function output_buffer_size(options)
+  if options.write_buffer_size then
+    return options.write_buffer_size
+  end
+  if not options.input_size then
+    return DEFAULT_BUFFER_SIZE
+  end
+  return math.min(math.max(math.ceil(options.input_size / 8), DEFAULT_BUFFER_SIZE), MAX_BUFFER_SIZE)
 end
 
-local function extract_audio(read_function, write_function)
-  local read_buffer_size = 8192
-  local read_exchange_area = ffi.C.malloc(read_buffer_size)
-  local first_packet = true
+-- codec parameters found for the first segment of each rendition, by rendition id
+local stream_layouts = {}
 
-  local io_input_context = avformat.avio_alloc_context(read_exchange_area, read_buffer_size, 0, nil, read_function, nil, nil)
+local function capture_stream_layout(input_context)
+  local layout = {iformat = input_context.iformat, nb_streams = input_context.nb_streams}
+  for i = 0, input_context.nb_streams - 1 do
+    local stream = input_context.streams[i]
+    local codec = compat.alloc_parameters()
+    av_assert(compat.copy_parameters(codec, compat.parameters(stream)))
+    layout[i] = {id = stream.id, codec = codec}
+  end
+  return layout
+end
+
+-- only applies when the new segment announces the very same streams
+local function apply_stream_layout(input_context, layout)
+  if input_context.nb_streams ~= layout.nb_streams then
+    return false
+  end
+  for i = 0, input_context.nb_streams - 1 do
+    if input_context.streams[i].id ~= layout[i].id then
+      return false
+    end
+  end
+  for i = 0, input_context.nb_streams - 1 do
+    av_assert(compat.copy_parameters(compat.parameters(input_context.streams[i]), layout[i].codec))
+  end
+  return true
+end
+
+M.clear_stream_layout = function(rendition)
+  if rendition then
+    stream_layouts[rendition] = nil
+  else
+    stream_layouts = {}
+  end
+end
+
+local input_formats = {}
+
+local function find_input_format(name)
+  if not name then
+    return nil
+  end
+  if not input_formats[name] then
+    local input_format = avformat.av_find_input_format(name)
+    if input_format == nil then
+      error("Unknown input format: " .. name)
+    end
+    input_formats[name] = input_format
+  end
+  return input_formats[name]
+end
+
+local function set_probe_options(input_context, options)
+  if options.probesize then
+    input_context.probesize = options.probesize
+  end
+  if options.max_analyze_duration then
+    input_context[compat.max_analyze_duration] = options.max_analyze_duration
+  end
+  if options.fps_probe_size then
+    input_context.fps_probe_size = options.fps_probe_size
+  end
+  if options.format_probesize then
+    input_context.format_probesize = options.format_probesize
+  end
+end
+
+-- output formats are looked up once instead of scanning the muxer list per call
+local adts_format = avformat.av_guess_format("adts", nil, nil)
+local mp4_format = avformat.av_guess_format("mp4", nil, nil)
+
+-- keeps AVIO buffers and packet storage alive across segments
+local Transmuxer = {}
+Transmuxer.__index = Transmuxer
+
+local function new_transmuxer()
+  return setmetatable({
+    buffers = {},
+    outputs = {},
+    packet = compat.new_packet(),
+    sink_packet = compat.new_packet(),
+  }, Transmuxer)
+end
+M.new_transmuxer = new_transmuxer
+
+-- hands out the pooled buffer of this kind, growing it to at least size,
+-- or to exactly size when exact is set; while lent to libavformat the
+-- buffer is not garbage collected
+function Transmuxer:take_buffer(kind, size, exact)
+  local buffer = self.buffers[kind]
+  self.buffers[kind] = nil
+  if buffer and (buffer.size == size or (buffer.size > size and not exact)) then
+    return ffi.gc(buffer.data, nil), buffer.size
+  end
+  if buffer then
+    avformat.av_free(ffi.gc(buffer.data, nil))
+  end
+  local data = avformat.av_malloc(size)
+  if data == nil then
+    error("Failed allocating io buffer")
+  end
+  return data, size
+end
+
+-- libavformat may have reallocated the buffer, so keep whatever it ended up with
+function Transmuxer:return_buffer(kind, io_context)
+  self.buffers[kind] = {data = ffi.gc(io_context.buffer, avformat.av_free), size = io_context.buffer_size}
+  io_context.buffer = nil
+  avformat.av_free(io_context)
+end
+
+-- frees whatever the last segment left open, also after an error
+function Transmuxer:release_contexts()
+  for i = #self.outputs, 1, -1 do
+    local output = self.outputs[i]
+    if output.context then
+      avformat.avformat_free_context(output.context)
+    end
+    if output.io_context then
+      self:return_buffer(output.kind, output.io_context)
+    else
+      self.buffers[output.kind] = {data = ffi.gc(output.buffer, avformat.av_free), size = output.size}
+    end
+    self.outputs[i] = nil
+  end
+  if self.pinput_context then
+    avformat.avformat_close_input(self.pinput_context)
+    self.pinput_context = nil
+  end
+  if self.io_input_context then
+    self:return_buffer("input", self.io_input_context)
+    self.io_input_context = nil
+  end
+  compat.packet_unref(self.packet)
+  compat.packet_unref(self.sink_packet)
+end
+
+function Transmuxer:close()
+  self:release_contexts()
+  for kind, buffer in pairs(self.buffers) do
+    avformat.av_free(ffi.gc(buffer.data, nil))
+  end
+  self.buffers = {}
+end
+
+-- runs body(self, ...) and releases the segment's contexts whatever happens
+local function guarded(body)
+  jit.off(body)
+  return function(self, ...)
+    local ok, err = pcall(body, self, ...)
+    self:release_contexts()
+    if not ok then
+      error(err, 0)
+    end
+  end
+end
+
+-- every output of a segment gets its own pooled buffer
+function Transmuxer:open_output(write_function, seek_function, options)
+  local kind = "output" .. #self.outputs
+  local buffer, buffer_size = self:take_buffer(kind, output_buffer_size(options), options.write_buffer_size ~= nil)
+  local io_context = avformat.avio_alloc_context(buffer, buffer_size, 1, nil, nil, write_function, seek_function)
+  if io_context == nil then
+    avformat.av_free(buffer)
+    error("Failed allocating io context")
+  end
+  local output = {kind = kind, io_context = io_context}
+  self.outputs[#self.outputs + 1] = output
+
+  local output_context = avformat.avformat_alloc_context()
+  if output_context == nil then
+    error("Failed allocating output context")
+  end
+  output.context = output_context
+  output_context.pb = io_context
+  return output_context
+end
+
+-- a pooled buffer for outputs that are written without libavformat
+function Transmuxer:open_staging(options)
+  local kind = "output" .. #self.outputs
+  local buffer, buffer_size = self:take_buffer(kind, output_buffer_size(options), options.write_buffer_size ~= nil)
+  self.outputs[#self.outputs + 1] = {kind = kind, buffer = buffer, size = buffer_size}
+  return buffer, buffer_size
+end
+
+-- segments of a rendition after the first one skip format and stream probing
+function Transmuxer:open_input(read_function, options)
+  local read_exchange_area, read_buffer_size = self:take_buffer("input", input_buffer_size(options),
+    options.read_buffer_size ~= nil)
+
+  local io_input_context = avformat.avio_alloc_context(read_exchange_area, read_buffer_size, 0, nil, read_function, nil,
+    options.input_seek_function)
+  if io_input_context == nil then
+    avformat.av_free(read_exchange_area)
+    error("Failed allocating io context")
+  end
+  self.io_input_context = io_input_context
 
   local pinput_context = ffi.new("AVFormatContext*[1]")
   local input_context = avformat.avformat_alloc_context()
+  if input_context == nil then
+    error("Failed allocating input context")
+  end
   input_context.pb = io_input_context
   pinput_context[0] = input_context
 
-  av_assert(avformat.avformat_open_input(pinput_context, "dummy", nil, nil))
-  av_assert(avformat.av_find_stream_info(input_context))
-  local audio_stream_id = av_assert(avformat.av_find_best_stream(input_context, avformat.AVMEDIA_TYPE_AUDIO, -1, -1, nil, 0))
+  local layout = options.rendition and stream_layouts[options.rendition]
+  local input_format = layout and layout.iformat or find_input_format(options.input_format)
+  set_probe_options(input_context, options)
+  -- on failure avformat_open_input frees the context itself
+  av_assert(avformat.avformat_open_input(pinput_context, "dummy", input_format, nil))
+  self.pinput_context = pinput_context
+  if not (layout and apply_stream_layout(input_context, layout)) then
+    av_assert(compat.find_stream_info(input_context))
+    if options.rendition then
+      stream_layouts[options.rendition] = capture_stream_layout(input_context)
+    end
+  end
+  return input_context
+end
+jit.off(Transmuxer.open_input)
+
+-- Sinks consume the packets of one demux pass: start() picks the streams
+-- they want (sink.streams) and opens their outputs on the transmuxer,
+-- write_packet() gets each packet of those streams and finish() runs at
+-- the end of the input.
+
+local AdtsSink = {}
+AdtsSink.__index = AdtsSink
+
+-- best (or options.stream_index) audio stream as ADTS behind the ID3 timestamp tag;
+-- with options.segment_pts, a sorted list of pts, a new tag also starts each
+-- segment there. sink.segments has the pts and output offset of every
+-- segment and sink.size the output size
+local function adts_sink(write_function, options)
+  return setmetatable({write_function = write_function, options = options or {}}, AdtsSink)
+end
+M.adts_sink = adts_sink
+
+-- AAC out of TS already comes in ADTS frames, and raw AAC only needs the
+-- 7-byte header derived from its AudioSpecificConfig; both are written
+-- directly, anything else goes through the libavformat adts muxer
+local ADTS_HEADER_SIZE = 7
+
+local function is_adts_frame(packet)
+  return packet.size >= ADTS_HEADER_SIZE and packet.data[0] == 0xFF and bit.band(packet.data[1], 0xF6) == 0xF0
+end
+
+-- the fixed part of the ADTS header, nil when it cannot express the config
+local function adts_header_template(parameters)
+  if parameters.extradata_size < 2 then
+    return nil
+  end
+  local config = parameters.extradata
+  local object_type = bit.rshift(config[0], 3)
+  local sampling_index = bit.bor(bit.lshift(bit.band(config[0], 7), 1), bit.rshift(config[1], 7))
+  local channels = bit.band(bit.rshift(config[1], 3), 15)
+  if object_type < 1 or object_type > 4 or sampling_index > 12 or channels == 0 then
+    return nil
+  end
+  local header = ffi.new("uint8_t[?]", ADTS_HEADER_SIZE)
+  header[0] = 0xFF
+  header[1] = 0xF1 -- MPEG-4, no CRC
+  header[2] = bit.bor(bit.lshift(object_type - 1, 6), bit.lshift(sampling_index, 2), bit.rshift(channels, 2))
+  header[3] = bit.lshift(bit.band(channels, 3), 6)
+  header[6] = 0xFC
+  return header
+end
+
+-- frame length goes in bits 30-42, with the buffer fullness fixed at 0x7FF
+local function set_adts_frame_length(header, length)
+  header[3] = bit.bor(bit.band(header[3], 0xFC), bit.rshift(length, 11))
+  header[4] = bit.band(bit.rshift(length, 3), 0xFF)
+  header[5] = bit.bor(bit.lshift(bit.band(length, 7), 5), 0x1F)
+end
+
+-- whether the stream can skip the muxer, and the header to add if so
+local function direct_adts(parameters)
+  if parameters.codec_id ~= avformat.AV_CODEC_ID_AAC then
+    return false
+  end
+  if parameters.extradata_size == 0 then
+    return true
+  end
+  local header = adts_header_template(parameters)
+  return header ~= nil, header
+end
+
+function AdtsSink:start(transmuxer, input_context)
+  local options = self.options
+  local audio_stream_id = options.stream_index or
+    av_assert(avformat.av_find_best_stream(input_context, avformat.AVMEDIA_TYPE_AUDIO, -1, -1, nil, 0))
+  self.streams = {[audio_stream_id] = true}
+  self.segments = {}
+  self.boundary = 2 -- the first segment starts with the first packet
+  self.tag_bytes = 0
 
   local input_audio_stream = input_context.streams[audio_stream_id]
-  local output_format_context = avformat.avformat_alloc_context()
-  local output_audio_stream = avformat.avformat_new_stream(output_format_context, nil)
+  local parameters = compat.parameters(input_audio_stream)
+  if options.reserve then
+    local estimate = estimate_output_size(input_context, parameters, options.input_size)
+    if estimate then
+      options.reserve(estimate)
+    end
+  end
 
-  local buffer_size = 8192
-  local exchange_area = ffi.C.malloc(buffer_size)
-  local io_context = avformat.avio_alloc_context(exchange_area, buffer_size, 1, nil, nil, write_function, nil)
+  self.direct, self.adts_header = direct_adts(parameters)
+  if self.direct then
+    self.staging, self.staging_size = transmuxer:open_staging(options)
+    self.staged = 0
+    self.written = 0
+    return
+  end
 
-  output_format_context.pb = io_context
-  output_format_context.oformat = avformat.av_guess_format("adts", nil, nil)
+  local output_format_context = transmuxer:open_output(self.write_function, nil, options)
+  output_format_context.oformat = adts_format
+  local output_audio_stream = avformat.avformat_new_stream(output_format_context, nil)
+  if output_audio_stream == nil then
+    error("Failed allocating output stream")
+  end
+  self.context = output_format_context
 
-  av_assert(avformat.avcodec_copy_context(output_audio_stream.codec, input_audio_stream.codec))
+  av_assert(compat.copy_parameters(compat.parameters(output_audio_stream), parameters))
   av_assert(avformat.avformat_write_header(output_format_context, nil))
+end
 
-  local packet = ffi.new("AVPacket")
+-- output written around the muxer, failing like the muxer would
+function AdtsSink:write(data, size)
+  av_assert(self.write_function(nil, data, size))
+end
 
-  while (avformat.av_read_frame(input_context, packet) >= 0) do
-    if packet.stream_index == audio_stream_id then
-      if first_packet then
-        local id3_tag = id3_header(tonumber(packet.pts))
-        write_function(nil, ffi.cast("uint8_t *", id3_tag), #id3_tag)
-        first_packet = false
-      end
-      packet.stream_index = 0
-      av_assert(avformat.av_interleaved_write_frame(output_format_context, packet))
+function AdtsSink:flush()
+  if self.staged > 0 then
+    self:write(self.staging, self.staged)
+    self.written = self.written + self.staged
+    self.staged = 0
+  end
+end
+
+-- copies into the staging buffer, which goes out whenever it is full
+function AdtsSink:stage(data, size)
+  if self.staged + size > self.staging_size then
+    self:flush()
+    if size >= self.staging_size then
+      self:write(data, size)
+      self.written = self.written + size
+      return
     end
-    avformat.av_free_packet(packet)
   end
+  ffi.copy(self.staging + self.staged, data, size)
+  self.staged = self.staged + size
+end
 
-  av_assert(avformat.av_write_trailer(output_format_context))
-  avformat.av_free(io_context)
-  avformat.av_free(io_input_context)
-  avformat.av_free(input_context)
-  avformat.avformat_free_context(output_format_context)
+-- bytes written around the muxer are added back to its position
+function AdtsSink:output_offset()
+  if self.direct then
+    return self.written + self.staged
+  end
+  return tonumber(avformat.avio_seek(self.context.pb, 0, SEEK_CUR)) + self.tag_bytes
 end
-jit.off(extract_audio)
-M.extract_audio = extract_audio
 
+function AdtsSink:start_segment(packet_pts)
+  local pts = tonumber(packet_pts)
+  if #self.segments > 0 and not self.direct then
+    avformat.avio_flush(self.context.pb)
+  end
+  self.segments[#self.segments + 1] = {pts = pts, offset = self:output_offset()}
+  local tag, tag_size = id3_header(packet_pts)
+  if self.direct then
+    self:stage(tag, tag_size)
+  else
+    self:write(tag, tag_size)
+    self.tag_bytes = self.tag_bytes + tag_size
+  end
+end
 
-local function remux(read_function, write_function, seek_function)
-  local read_buffer_size = 8192
-  local read_exchange_area = ffi.C.malloc(read_buffer_size)
+function AdtsSink:write_packet(packet)
+  local boundaries = self.options.segment_pts
+  local pts = packet.pts ~= AV_NOPTS_VALUE and tonumber(packet.pts)
+  -- the first segment waits for a pts, so no tag carries AV_NOPTS_VALUE
+  if pts and #self.segments == 0 then
+    self:start_segment(packet.pts)
+  elseif boundaries and pts and boundaries[self.boundary] and pts >= boundaries[self.boundary] then
+    self:start_segment(packet.pts)
+  end
+  if boundaries and pts then
+    while boundaries[self.boundary] and boundaries[self.boundary] <= pts do
+      self.boundary = self.boundary + 1
+    end
+    self.end_pts = pts + tonumber(packet.duration)
+  end
 
-  local io_input_context = avformat.avio_alloc_context(read_exchange_area, read_buffer_size, 0, nil, read_function, nil, nil)
+  if self.direct then
+    if packet.size == 0 then
+      return
+    end
+    -- a raw frame gets a header, unless the packets turn out to be framed already
+    if self.adts_header and not is_adts_frame(packet) then
+      set_adts_frame_length(self.adts_header, packet.size + ADTS_HEADER_SIZE)
+      self:stage(self.adts_header, ADTS_HEADER_SIZE)
+    end
+    self:stage(packet.data, packet.size)
+    return
+  end
 
-  local pinput_context = ffi.new("AVFormatContext*[1]")
-  local input_context = avformat.avformat_alloc_context()
-  input_context.pb = io_input_context
-  pinput_context[0] = input_context
+  packet.stream_index = 0
+  -- a single stream needs no interleaving, so packets skip the muxer queue
+  av_assert(avformat.av_write_frame(self.context, packet))
+end
+
+function AdtsSink:finish()
+  if self.direct then
+    self:flush()
+    self.size = self.written
+    return
+  end
+  av_assert(avformat.av_write_frame(self.context, nil))
+  avformat.avio_flush(self.context.pb)
+  av_assert(avformat.av_write_trailer(self.context))
+  self.size = self:output_offset()
+end
 
-  av_assert(avformat.avformat_open_input(pinput_context, "dummy", nil, nil))
-  av_assert(avformat.av_find_stream_info(input_context))
+local Mp4Sink = {}
+Mp4Sink.__index = Mp4Sink
 
-  local ofmt_ctx = avformat.avformat_alloc_context()
+-- fragments start on keyframes and the moov goes first, so nothing is rewritten
+local FRAGMENTED_MOVFLAGS = "frag_keyframe+empty_moov+default_base_moof"
+
+-- every stream remuxed into mp4; with options.fragmented the output is
+-- written strictly forward and seek_function may be nil. options.interleaved
+-- declares the input already in dts order across streams (as TS usually is),
+-- so packets go straight to the muxer instead of through its interleave queue
+local function mp4_sink(write_function, seek_function, options)
+  return setmetatable({write_function = write_function, seek_function = seek_function, options = options or {}}, Mp4Sink)
+end
+M.mp4_sink = mp4_sink
 
-  local buffer_size = 8192
-  local exchange_area = ffi.C.malloc(buffer_size)
-  local io_context = avformat.avio_alloc_context(exchange_area, buffer_size, 1, nil, nil, write_function, seek_function)
+function Mp4Sink:start(transmuxer, input_context)
+  local ofmt_ctx = transmuxer:open_output(self.write_function, self.seek_function, self.options)
+  self.context = ofmt_ctx
+  self.streams = {}
 
   avformat.av_dump_format(input_context, 0, "video.ts", 0)
 
-  ofmt_ctx.pb = io_context
-  ofmt_ctx.oformat = avformat.av_guess_format("mp4", nil, nil)
-  local ofmt = ofmt_ctx.oformat
+  ofmt_ctx.oformat = mp4_format
 
   for i = 0, input_context.nb_streams - 1 do
     local in_stream = input_context.streams[i]
-    local codec = in_stream.codec.codec
-    local out_stream = avformat.avformat_new_stream(ofmt_ctx, codec)
-    if not out_stream then
-      error("Failed allocatation output stream")
+    local out_stream = avformat.avformat_new_stream(ofmt_ctx, compat.stream_codec(in_stream))
+    if out_stream == nil then
+      error("Failed allocating output stream")
     end
-    av_assert(avformat.avcodec_copy_context(out_stream.codec, in_stream.codec))
-    out_stream.codec.codec_tag = 0
+    av_assert(compat.copy_parameters(compat.parameters(out_stream), compat.parameters(in_stream)))
+    compat.parameters(out_stream).codec_tag = 0
     if bit.band(ofmt_ctx.oformat.flags, AVFMT_GLOBALHEADER) then
-      out_stream.codec.flags = bit.bor(out_stream.codec.flags, CODEC_FLAG_GLOBAL_HEADER)
+      compat.set_global_header(out_stream)
     end
+    self.streams[i] = true
   end
+  self.interleaved = self.options.interleaved or input_context.nb_streams == 1
 
   avformat.av_dump_format(ofmt_ctx, 0, "dummy.mp4", 1)
-  av_assert(avformat.avformat_write_header(ofmt_ctx, nil))
 
-  local packet = ffi.new("AVPacket")
+  local muxer_options = ffi.new("AVDictionary*[1]")
+  if self.options.fragmented then
+    av_assert(avformat.av_dict_set(muxer_options, "movflags", FRAGMENTED_MOVFLAGS, 0))
+    -- hand each fragment to write_function as soon as the muxer emits it
+    ofmt_ctx.flush_packets = 1
+    ofmt_ctx.flags = bit.bor(ofmt_ctx.flags, AVFMT_FLAG_FLUSH_PACKETS)
+  end
+  local ret = avformat.avformat_write_header(ofmt_ctx, muxer_options)
+  avformat.av_dict_free(muxer_options)
+  av_assert(ret)
+end
+
+function Mp4Sink:write_packet(packet, input_context)
+  local in_stream = input_context.streams[packet.stream_index]
+  local out_stream = self.context.streams[packet.stream_index]
+
+  local round_flag = bit.bor(AV_ROUND_NEAR_INF, AV_ROUND_PASS_MINMAX)
+  packet.pts = avformat.av_rescale_q_rnd(packet.pts, in_stream.time_base, out_stream.time_base, round_flag)
+  packet.dts = avformat.av_rescale_q_rnd(packet.dts, in_stream.time_base, out_stream.time_base, round_flag)
+  packet.duration = avformat.av_rescale_q(packet.duration, in_stream.time_base, out_stream.time_base)
+  packet.pos = -1
+
+  if self.interleaved then
+    av_assert(avformat.av_write_frame(self.context, packet))
+  else
+    av_assert(avformat.av_interleaved_write_frame(self.context, packet))
+  end
+end
+
+function Mp4Sink:finish()
+  if self.interleaved then
+    av_assert(avformat.av_write_frame(self.context, nil))
+    avformat.avio_flush(self.context.pb)
+  end
+  av_assert(avformat.av_write_trailer(self.context))
+end
+
+local ElementarySink = {}
+ElementarySink.__index = ElementarySink
+
+-- raw packet payloads of one stream, as demuxed
+local function elementary_sink(stream_index, write_function)
+  return setmetatable({streams = {[stream_index] = true}, write_function = write_function}, ElementarySink)
+end
+M.elementary_sink = elementary_sink
+
+function ElementarySink:start()
+end
+
+function ElementarySink:write_packet(packet)
+  av_assert(self.write_function(nil, packet.data, packet.size))
+end
+
+function ElementarySink:finish()
+end
+
+local StatsSink = {}
+StatsSink.__index = StatsSink
+
+-- per stream packet, byte and keyframe counts and pts range, in sink.stats
+local function stats_sink()
+  return setmetatable({stats = {}}, StatsSink)
+end
+M.stats_sink = stats_sink
+
+function StatsSink:start(transmuxer, input_context)
+  self.streams = {}
+  for i = 0, input_context.nb_streams - 1 do
+    self.streams[i] = true
+    self.stats[i] = {packets = 0, bytes = 0, keyframes = 0}
+  end
+end
+
+function StatsSink:write_packet(packet)
+  local stats = self.stats[packet.stream_index]
+  stats.packets = stats.packets + 1
+  stats.bytes = stats.bytes + packet.size
+  if bit.band(packet.flags, AV_PKT_FLAG_KEY) ~= 0 then
+    stats.keyframes = stats.keyframes + 1
+  end
+  if packet.pts ~= AV_NOPTS_VALUE then
+    local pts = tonumber(packet.pts)
+    stats.first_pts = stats.first_pts or pts
+    stats.last_pts = pts
+  end
+end
+
+function StatsSink:finish()
+end
+
+local AudioTracksSink = {}
+AudioTracksSink.__index = AudioTracksSink
+
+-- one ADTS output per audio stream, write_for_stream(stream_index) giving its callback
+local function audio_tracks_sink(write_for_stream, options)
+  return setmetatable({write_for_stream = write_for_stream, options = options or {}, tracks = {}}, AudioTracksSink)
+end
+M.audio_tracks_sink = audio_tracks_sink
+
+function AudioTracksSink:start(transmuxer, input_context)
+  self.streams = {}
+  for i = 0, input_context.nb_streams - 1 do
+    if compat.parameters(input_context.streams[i]).codec_type == avformat.AVMEDIA_TYPE_AUDIO then
+      local track = adts_sink(self.write_for_stream(i), setmetatable({stream_index = i}, {__index = self.options}))
+      track:start(transmuxer, input_context)
+      self.tracks[i] = track
+      self.streams[i] = true
+    end
+  end
+  if next(self.tracks) == nil then
+    av_assert(AVERROR_STREAM_NOT_FOUND)
+  end
+end
+
+function AudioTracksSink:write_packet(packet, input_context)
+  self.tracks[packet.stream_index]:write_packet(packet, input_context)
+end
+
+function AudioTracksSink:finish()
+  for _, track in pairs(self.tracks) do
+    track:finish()
+  end
+end
+
+local INDEX_MAGIC = "TSIX"
+local INDEX_VERSION = 1
+local INDEX_ENTRY_SIZE = ffi.sizeof("transmux_index_entry")
+local INDEX_HEADER_SIZE = ffi.sizeof("transmux_index_header")
+
+local Index = {}
+Index.__index = Index
+
+-- entries are grouped by stream and sorted by pts within each group;
+-- video_stream is the stream segments are cut on, or -1
+local function new_index(count, entries, video_stream)
+  local index = setmetatable({count = count, entries = entries, video_stream = video_stream, ranges = {}}, Index)
+  for i = 0, count - 1 do
+    local stream_index = entries[i].stream_index
+    local range = index.ranges[stream_index]
+    if range then
+      range.last = i
+    else
+      index.ranges[stream_index] = {first = i, last = i}
+    end
+  end
+  return index
+end
+
+-- last entry of the stream at or before pts (its first one if pts is
+-- earlier than all of them), or nil when the stream is not indexed
+function Index:lookup(stream_index, pts)
+  local range = self.ranges[stream_index]
+  if not range then
+    return nil
+  end
+  local entries = self.entries
+  local low, high = range.first, range.last
+  while low < high do
+    local mid = high - math.floor((high - low) / 2)
+    if entries[mid].pts <= pts then
+      low = mid
+    else
+      high = mid - 1
+    end
+  end
+  return entries[low]
+end
+
+-- header and entries in host byte order
+function Index:serialize()
+  local header = ffi.new("transmux_index_header", INDEX_MAGIC, INDEX_VERSION, self.count, self.video_stream)
+  return ffi.string(header, INDEX_HEADER_SIZE) .. ffi.string(self.entries, self.count * INDEX_ENTRY_SIZE)
+end
+
+local function load_index(data)
+  if #data < INDEX_HEADER_SIZE then
+    error("Truncated index")
+  end
+  local header = ffi.new("transmux_index_header")
+  ffi.copy(header, data, INDEX_HEADER_SIZE)
+  if ffi.string(header.magic, 4) ~= INDEX_MAGIC or header.version ~= INDEX_VERSION then
+    error("Not a transmux index")
+  end
+  local count = header.count
+  if #data < INDEX_HEADER_SIZE + count * INDEX_ENTRY_SIZE then
+    error("Truncated index")
+  end
+  local entries = ffi.new("transmux_index_entry[?]", count)
+  ffi.copy(entries, ffi.cast("const char *", data) + INDEX_HEADER_SIZE, count * INDEX_ENTRY_SIZE)
+  return new_index(count, entries, header.video_stream)
+end
+M.load_index = load_index
+
+local IndexSink = {}
+IndexSink.__index = IndexSink
+
+-- video keyframes and, every options.index_interval seconds (1 by default),
+-- a packet of each other stream, with their byte offsets; in sink.index
+local function index_sink(options)
+  return setmetatable({options = options or {}, pending = {}, intervals = {}}, IndexSink)
+end
+M.index_sink = index_sink
+
+function IndexSink:start(transmuxer, input_context)
+  self.streams = {}
+  local interval = self.options.index_interval or 1
+  self.nb_streams = input_context.nb_streams
+  self.video_stream = -1
+  for i = 0, input_context.nb_streams - 1 do
+    local stream = input_context.streams[i]
+    self.streams[i] = true
+    self.pending[i] = {}
+    if compat.parameters(stream).codec_type ~= avformat.AVMEDIA_TYPE_VIDEO then
+      self.intervals[i] = interval * stream.time_base.den / stream.time_base.num
+    elseif self.video_stream < 0 then
+      self.video_stream = i
+    end
+  end
+end
+
+function IndexSink:write_packet(packet)
+  if packet.pts == AV_NOPTS_VALUE or packet.pos < 0 then
+    return
+  end
+  local pending = self.pending[packet.stream_index]
+  local interval = self.intervals[packet.stream_index]
+  local pts = tonumber(packet.pts)
+  if interval then
+    local last = pending[#pending]
+    if last and pts - last.pts < interval then
+      return
+    end
+  elseif bit.band(packet.flags, AV_PKT_FLAG_KEY) == 0 then
+    return
+  end
+  pending[#pending + 1] = {pts = pts, pos = tonumber(packet.pos), flags = packet.flags}
+end
+
+function IndexSink:finish()
+  local count = 0
+  for _, pending in pairs(self.pending) do
+    count = count + #pending
+  end
+  local entries = ffi.new("transmux_index_entry[?]", count)
+  local n = 0
+  for stream_index = 0, self.nb_streams - 1 do
+    local pending = self.pending[stream_index]
+    table.sort(pending, function(a, b) return a.pts < b.pts end)
+    for _, entry in ipairs(pending) do
+      local e = entries[n]
+      e.pts, e.pos, e.stream_index, e.flags = entry.pts, entry.pos, stream_index, entry.flags
+      n = n + 1
+    end
+  end
+  self.index = new_index(count, entries, self.video_stream)
+end
+
+for _, sink in ipairs({AdtsSink, Mp4Sink, ElementarySink, StatsSink, AudioTracksSink, IndexSink}) do
+  jit.off(sink.start)
+  jit.off(sink.write_packet)
+  jit.off(sink.finish)
+end
+jit.off(AdtsSink.start_segment)
+jit.off(AdtsSink.write)
+jit.off(AdtsSink.flush)
+jit.off(AdtsSink.stage)
+
+-- sinks may modify the packet, so each gets its own reference when it is
+-- shared; the payload itself is never copied, and muxers take over the
+-- reference instead of duplicating the data into their queues
+function Transmuxer:packet_for_sink(packet, shared)
+  if not shared then
+    return packet
+  end
+  local sink_packet = self.sink_packet
+  compat.packet_unref(sink_packet)
+  av_assert(avformat.av_packet_ref(sink_packet, packet))
+  return sink_packet
+end
+
+local function packet_time(packet)
+  if packet.dts ~= AV_NOPTS_VALUE then
+    return packet.dts
+  end
+  return packet.pts
+end
+
+-- start_pts and end_pts are in the time base of the packet's stream
+local function outside_range(packet, start_pts, end_pts)
+  if packet.pts == AV_NOPTS_VALUE then
+    return false
+  end
+  return (start_pts and packet.pts < start_pts) or (end_pts and packet.pts >= end_pts)
+end
+
+-- jumps close to start_pts, by timestamp when the demuxer can, or else by
+-- a byte offset estimated from the stream duration, a second early
+local function seek_input(input_context, stream_index, start_pts)
+  if avformat.avformat_seek_file(input_context, stream_index, INT64_MIN, start_pts, start_pts, 0) >= 0 then
+    return
+  end
+  local stream = input_context.streams[stream_index]
+  local size = tonumber(avformat.avio_size(input_context.pb))
+  local duration = tonumber(stream.duration)
+  if size <= 0 or duration <= 0 or stream.start_time == AV_NOPTS_VALUE then
+    return
+  end
+  local second = stream.time_base.den / stream.time_base.num
+  local position = tonumber(start_pts - stream.start_time) - second
+  local offset = math.floor(size * math.max(position, 0) / duration)
+  avformat.av_seek_frame(input_context, -1, offset, AVSEEK_FLAG_BYTE)
+end
+jit.off(seek_input)
+
+-- jumps to the earliest indexed offset at or before start_pts among the
+-- wanted streams
+local function seek_indexed(input_context, index, wanted, start_pts)
+  local offset
+  for stream_index in pairs(wanted) do
+    local entry = index:lookup(stream_index, start_pts)
+    if entry and (not offset or entry.pos < offset) then
+      offset = entry.pos
+    end
+  end
+  if not offset then
+    return seek_input(input_context, next(wanted), start_pts)
+  end
+  av_assert(avformat.av_seek_frame(input_context, -1, offset, AVSEEK_FLAG_BYTE))
+end
+jit.off(seek_indexed)
+
+-- a single demux pass feeding every sink
+local function demux_segment(self, read_function, sinks, options)
+  options = options or {}
+  local input_context = self:open_input(read_function, options)
+
+  local wanted = {}
+  for _, sink in ipairs(sinks) do
+    sink:start(self, input_context)
+    for stream_index in pairs(sink.streams) do
+      wanted[stream_index] = true
+    end
+  end
+  -- let the demuxer skip payload reassembly for streams no sink wants
+  for i = 0, input_context.nb_streams - 1 do
+    if not wanted[i] then
+      input_context.streams[i].discard = avformat.AVDISCARD_ALL
+    end
+  end
+
+  local start_pts, end_pts = options.start_pts, options.end_pts
+  local remaining = 0
+  for stream_index in pairs(wanted) do
+    remaining = remaining + 1
+  end
+  if start_pts and options.input_seek_function and next(wanted) then
+    if options.index then
+      seek_indexed(input_context, options.index, wanted, start_pts)
+    else
+      seek_input(input_context, next(wanted), start_pts)
+    end
+  end
+
+  local packet = self.packet
+  compat.init_packet(packet)
+  local shared = #sinks > 1
+  local passed = {}
 
   while (avformat.av_read_frame(input_context, packet) >= 0) do
-    local in_stream = input_context.streams[packet.stream_index]
-    local out_stream = ofmt_ctx.streams[packet.stream_index]
+    compat.make_refcounted(packet)
+    -- read before the sinks get the packet, they may rescale or renumber it
+    local stream_index, time = packet.stream_index, packet_time(packet)
+    if not outside_range(packet, start_pts, end_pts) then
+      for _, sink in ipairs(sinks) do
+        if sink.streams[stream_index] then
+          sink:write_packet(self:packet_for_sink(packet, shared), input_context)
+        end
+      end
+    end
+    -- decode order never goes back, so a stream is done once its dts passes end_pts
+    if end_pts and not passed[stream_index] and wanted[stream_index] and
+        time ~= AV_NOPTS_VALUE and time >= end_pts then
+      passed[stream_index] = true
+      remaining = remaining - 1
+    end
+    compat.packet_unref(packet)
+    if end_pts and remaining == 0 then
+      break
+    end
+  end
+
+  for _, sink in ipairs(sinks) do
+    sink:finish()
+  end
+end
+Transmuxer.demux = guarded(demux_segment)
 
-    local round_flag = bit.bor(AV_ROUND_NEAR_INF, AV_ROUND_PASS_MINMAX)
-    packet.pts = avformat.av_rescale_q_rnd(packet.pts, in_stream.time_base, out_stream.time_base, round_flag)
-    packet.dts = avformat.av_rescale_q_rnd(packet.dts, in_stream.time_base, out_stream.time_base, round_flag)
-    packet.duration = avformat.av_rescale_q(packet.duration, in_stream.time_base, out_stream.time_base)
-    packet.pos = -1
+function Transmuxer:extract_audio(read_function, write_function, options)
+  self:demux(read_function, {adts_sink(write_function, options)}, options)
+end
+
+function Transmuxer:remux(read_function, write_function, seek_function, options)
+  self:demux(read_function, {mp4_sink(write_function, seek_function, options)}, options)
+end
+
+local transmuxer_pool = {}
 
-    av_assert(avformat.av_interleaved_write_frame(ofmt_ctx, packet))
-    avformat.av_free_packet(packet)
+local function acquire_transmuxer()
+  return table.remove(transmuxer_pool) or new_transmuxer()
+end
+M.acquire_transmuxer = acquire_transmuxer
+
+local function release_transmuxer(transmuxer)
+  transmuxer_pool[#transmuxer_pool + 1] = transmuxer
+end
+M.release_transmuxer = release_transmuxer
+
+-- contexts are released on errors too, so the transmuxer goes back either way
+local function demux(read_function, sinks, options)
+  local transmuxer = acquire_transmuxer()
+  local ok, err = pcall(transmuxer.demux, transmuxer, read_function, sinks, options)
+  release_transmuxer(transmuxer)
+  if not ok then
+    error(err, 0)
   end
+end
+M.demux = demux
 
-  av_assert(avformat.av_write_trailer(ofmt_ctx))
-  avformat.av_free(io_context)
-  avformat.av_free(io_input_context)
-  avformat.av_free(input_context)
-  avformat.avformat_free_context(ofmt_ctx)
+local function extract_audio(read_function, write_function, options)
+  local transmuxer = acquire_transmuxer()
+  local ok, err = pcall(transmuxer.extract_audio, transmuxer, read_function, write_function, options)
+  release_transmuxer(transmuxer)
+  if not ok then
+    error(err, 0)
+  end
+end
+M.extract_audio = extract_audio
+
+-- every audio stream in a single pass, see audio_tracks_sink
+local function extract_all_audio(read_function, write_for_stream, options)
+  demux(read_function, {audio_tracks_sink(write_for_stream, options)}, options)
+end
+M.extract_all_audio = extract_all_audio
+
+-- scans the whole input once, see index_sink
+local function build_index(read_function, options)
+  local sink = index_sink(options)
+  demux(read_function, {sink}, options)
+  return sink.index
+end
+M.build_index = build_index
+
+-- splits the indexed video stream (or options.video_stream_index) on
+-- keyframes into segments of at least options.target_duration seconds
+-- (6 by default); size is the input size
+local function hls_segments(index, size, options)
+  options = options or {}
+  local range = index.ranges[options.video_stream_index or index.video_stream]
+  if not range then
+    error("No video keyframes in index")
+  end
+  local clock = options.clock or 90000
+  local target = (options.target_duration or 6) * clock
+  local entries = index.entries
+
+  local segments = {}
+  for i = range.first, range.last do
+    local pts = tonumber(entries[i].pts)
+    local last = segments[#segments]
+    if not last or pts - last.pts >= target then
+      segments[#segments + 1] = {pts = pts, offset = tonumber(entries[i].pos)}
+    end
+  end
+
+  local end_pts = 0
+  for _, stream_range in pairs(index.ranges) do
+    end_pts = math.max(end_pts, tonumber(entries[stream_range.last].pts))
+  end
+  for i, segment in ipairs(segments) do
+    local following = segments[i + 1]
+    segment.duration = ((following and following.pts or end_pts) - segment.pts) / clock
+    segment.length = (following and following.offset or size) - segment.offset
+  end
+  return segments
+end
+M.hls_segments = hls_segments
+
+-- offset of the TS payload, or nil if the packet carries none
+local function ts_payload_offset(packet)
+  local adaptation_field_control = bit.band(bit.rshift(packet[3], 4), 3)
+  if bit.band(adaptation_field_control, 1) == 0 then
+    return nil
+  end
+  local offset = bit.band(adaptation_field_control, 2) ~= 0 and 5 + packet[4] or 4
+  return offset < TS_PACKET_SIZE and offset or nil
+end
+
+-- byte range ({offset, length}) from the first PAT to the PMT of its first
+-- program, which every segment not starting at offset 0 needs as its
+-- EXT-X-MAP; nil when the tables are not found, and nil, "not TS" when the
+-- input is not a whole number of TS packets
+local function ts_program_tables(input, size)
+  if size % TS_PACKET_SIZE ~= 0 then
+    return nil, "not TS"
+  end
+  local pat_offset, pmt_pid
+  for offset = 0, size - TS_PACKET_SIZE, TS_PACKET_SIZE do
+    local packet = input + offset
+    if packet[0] ~= 0x47 then
+      return nil, "not TS"
+    end
+    local pid = bit.bor(bit.lshift(bit.band(packet[1], 0x1f), 8), packet[2])
+    local payload = bit.band(packet[1], 0x40) ~= 0 and ts_payload_offset(packet)
+    local section = payload and payload + 1 + packet[payload]
+    if section and pid == 0 and not pmt_pid and section + 3 <= TS_PACKET_SIZE then
+      -- program entries follow the 8-byte section header, up to the CRC
+      local section_length = bit.bor(bit.lshift(bit.band(packet[section + 1], 0x0f), 8), packet[section + 2])
+      local entries_end = math.min(section + 3 + section_length - 4, TS_PACKET_SIZE)
+      for entry = section + 8, entries_end - 4, 4 do
+        -- program 0 points to the network PID
+        if packet[entry] ~= 0 or packet[entry + 1] ~= 0 then
+          pat_offset = offset
+          pmt_pid = bit.bor(bit.lshift(bit.band(packet[entry + 2], 0x1f), 8), packet[entry + 3])
+          break
+        end
+      end
+    elseif payload and pid == pmt_pid then
+      return {offset = pat_offset, length = offset + TS_PACKET_SIZE - pat_offset}
+    end
+  end
+  return nil
+end
+M.ts_program_tables = ts_program_tables
+
+-- EXT-X-BYTERANGE media playlist of segments ({duration, offset, length}) in
+-- uri; map, a range of uri like the segments, goes in an EXT-X-MAP tag
+local function byterange_playlist(segments, uri, map)
+  local target_duration = 1
+  for _, segment in ipairs(segments) do
+    target_duration = math.max(target_duration, math.ceil(segment.duration))
+  end
+  local lines = {
+    "#EXTM3U",
+    -- EXT-X-MAP outside of I-frame playlists needs version 6
+    "#EXT-X-VERSION:" .. (map and 6 or 4),
+    "#EXT-X-TARGETDURATION:" .. target_duration,
+    "#EXT-X-MEDIA-SEQUENCE:0",
+    "#EXT-X-PLAYLIST-TYPE:VOD",
+  }
+  if map then
+    lines[#lines + 1] = string.format('#EXT-X-MAP:URI="%s",BYTERANGE="%d@%d"', uri, map.length, map.offset)
+  end
+  for _, segment in ipairs(segments) do
+    lines[#lines + 1] = string.format("#EXTINF:%.3f,", segment.duration)
+    lines[#lines + 1] = string.format("#EXT-X-BYTERANGE:%d@%d", segment.length, segment.offset)
+    lines[#lines + 1] = uri
+  end
+  lines[#lines + 1] = "#EXT-X-ENDLIST"
+  return table.concat(lines, "\n") .. "\n"
+end
+M.byterange_playlist = byterange_playlist
+
+-- audio segments as written by an adts_sink with segment_pts
+local function adts_segments(sink, clock)
+  local segments = {}
+  for i, segment in ipairs(sink.segments) do
+    local following = sink.segments[i + 1]
+    segments[i] = {
+      offset = segment.offset,
+      length = (following and following.offset or sink.size) - segment.offset,
+      duration = ((following and following.pts or sink.end_pts) - segment.pts) / (clock or 90000),
+    }
+  end
+  return segments
+end
+M.adts_segments = adts_segments
+
+local function remux(read_function, write_function, seek_function, options)
+  local transmuxer = acquire_transmuxer()
+  local ok, err = pcall(transmuxer.remux, transmuxer, read_function, write_function, seek_function, options)
+  release_transmuxer(transmuxer)
+  if not ok then
+    error(err, 0)
+  end
 end
-jit.off(remux)
 M.remux = remux
 
-M.extract_audio_from_string = function(data)
-  local pos = 1
+-- copies straight out of memory, without creating substrings; with
+-- seekable set a matching seek callback is returned as well
+local function memory_reader(input, size, seekable)
+  local pos = 0
 
   local read_function = ffi.cast(callback, function(opaque, buf, buf_size)
-    local final_pos = math.min(pos + buf_size, #data + 1)
-    local delta = final_pos - pos
+    local delta = math.min(buf_size, size - pos)
     if delta == 0 then
       return 0
     end
-    ffi.copy(buf, string.sub(data, pos, final_pos - 1), delta)
-    pos = final_pos
+    ffi.copy(buf, input + pos, delta)
+    pos = pos + delta
     return delta
   end)
 
-  local output = {}
+  local seek_function = seekable and ffi.cast(seek_callback, function(opaque, offset, whence)
+    whence = bit.band(whence, bit.bnot(AVSEEK_FORCE))
+    if whence == AVSEEK_SIZE then
+      return size
+    end
+    local base = ({[0] = 0, [1] = pos, [2] = size})[whence]
+    if not base then
+      return -1
+    end
+    pos = math.max(0, math.min(base + tonumber(offset), size))
+    return pos
+  end)
+
+  return read_function, seek_function
+end
+
+-- strings read in place stay alive for as long as their reader does
+local reader_anchors = setmetatable({}, {__mode = 'k'})
+
+local function string_reader(data, seekable)
+  local read_function, seek_function = memory_reader(ffi.cast("const uint8_t *", data), #data, seekable)
+  reader_anchors[read_function] = data
+  return read_function, seek_function
+end
+M.string_reader = string_reader
+
+-- With the shim loaded, reads a copy of the TS made without its video
+-- packets, so that they never reach the demuxer when only audio is wanted.
+-- Byte positions and seeks then refer to the copy, which is why callers
+-- holding offsets into the full input (options.index) pass full = true.
+local function audio_reader(input, size, seekable, full)
+  if native and not full then
+    local filtered_size = ffi.new("size_t[1]")
+    local filtered = native.transmux_ts_audio_only(input, size, filtered_size)
+    if filtered ~= nil then
+      filtered = ffi.gc(filtered, avformat.av_free)
+      local read_function, seek_function = memory_reader(filtered, tonumber(filtered_size[0]), seekable)
+      reader_anchors[read_function] = filtered
+      return read_function, seek_function
+    end
+  end
+  return memory_reader(input, size, seekable)
+end
+
+-- options transmux_extract_audio does not take; with any of them set the
+-- audio is extracted in Lua instead
+local lua_only_options = {"start_pts", "end_pts", "stream_index", "rendition", "input_format", "probesize",
+  "max_analyze_duration", "fps_probe_size", "format_probesize", "read_buffer_size", "write_buffer_size"}
+
+local function use_native(options)
+  if not native then
+    return false
+  end
+  for _, name in ipairs(lua_only_options) do
+    if options[name] ~= nil then
+      return false
+    end
+  end
+  return true
+end
+
+local function native_extract_audio_from_string(data, capacity)
+  local output = ffi.new("transmux_buffer")
+  output.data = ffi.C.malloc(capacity)
+  if output.data ~= nil then
+    output.capacity = capacity
+  end
+  local ret = native.transmux_extract_audio(data, #data, native.transmux_buffer_write, output)
+  local result = setmetatable({size = tonumber(output.size), capacity = tonumber(output.capacity)}, Buffer)
+  if output.data ~= nil then
+    result.data = ffi.gc(output.data, ffi.C.free)
+  end
+  av_assert(ret)
+  return result
+end
+
+-- returns the ADTS output as a string, or as a Buffer (data pointer + size)
+-- when options.output is "buffer"
+M.extract_audio_from_string = function(data, options)
+  options = options or {}
+  -- until the audio bitrate is known, assume the usual audio share of a segment
+  local capacity = math.max(math.ceil(#data / 8), 8192)
+  local output
+
+  local time_range = options.start_pts or options.end_pts
+
+  if use_native(options) then
+    output = native_extract_audio_from_string(data, capacity)
+  else
+    output = new_buffer(capacity)
+    local read_function, seek_function = audio_reader(ffi.cast("const uint8_t *", data), #data, time_range,
+      options.index)
+    reader_anchors[read_function] = reader_anchors[read_function] or data
+    local write_function = ffi.cast(callback, function(opaque, buf, buf_size)
+      return output:write(buf, buf_size)
+    end)
+
+    local ok, err = pcall(extract_audio, read_function, write_function, setmetatable({
+      input_size = #data,
+      input_seek_function = seek_function,
+      reserve = function(size) output:reserve(size) end,
+    }, {__index = options}))
+    read_function:free()
+    write_function:free()
+    if seek_function then
+      seek_function:free()
+    end
+    if not ok then
+      error(err, 0)
+    end
+  end
+
+  if options.output == "buffer" then
+    return output
+  end
+  return output:tostring()
+end
+
+-- like transmux_fd_write: retries on EINTR, fails with AVERROR(errno)
+local function write_all(fd, buf, buf_size)
+  local written = 0
+  while written < buf_size do
+    local ret = tonumber(ffi.C.write(fd, buf + written, buf_size - written))
+    if ret < 0 then
+      local errno = ffi.errno()
+      if errno ~= EINTR then
+        return -errno
+      end
+    else
+      written = written + ret
+    end
+  end
+  return buf_size
+end
+
+-- returns the ADTS output of every audio stream, by stream index
+M.extract_all_audio_from_string = function(data, options)
+  local outputs, write_functions = {}, {}
+  local read_function = audio_reader(ffi.cast("const uint8_t *", data), #data)
+  reader_anchors[read_function] = reader_anchors[read_function] or data
+
+  local function write_for_stream(stream_index)
+    local output = new_buffer(math.max(math.ceil(#data / 8), 8192))
+    local write_function = ffi.cast(callback, function(opaque, buf, buf_size)
+      return output:write(buf, buf_size)
+    end)
+    outputs[stream_index] = output
+    write_functions[#write_functions + 1] = write_function
+    return write_function
+  end
+
+  local ok, err = pcall(extract_all_audio, read_function, write_for_stream,
+    setmetatable({input_size = #data}, {__index = options}))
+  read_function:free()
+  for _, write_function in ipairs(write_functions) do
+    write_function:free()
+  end
+  if not ok then
+    error(err, 0)
+  end
+
+  local result = {}
+  for stream_index, output in pairs(outputs) do
+    result[stream_index] = output:tostring()
+  end
+  return result
+end
+
+local function map_file(path)
+  local fd = ffi.C.open(path, O_RDONLY)
+  if fd < 0 then
+    error("Failed opening " .. path)
+  end
+  local size = tonumber(ffi.C.lseek(fd, 0, SEEK_END))
+  local data = size > 0 and ffi.C.mmap(nil, size, PROT_READ, MAP_PRIVATE, fd, 0) or MAP_FAILED
+  ffi.C.close(fd)
+  if data == MAP_FAILED then
+    error("Failed mapping " .. path)
+  end
+  ffi.C.madvise(data, size, MADV_SEQUENTIAL)
+  return data, size
+end
+
+-- one pass over the mmap'ed TS in path writing its audio into audio_path,
+-- returning byte range playlists for both; options.index skips indexing,
+-- options.uri and options.audio_uri name the files in the playlists
+M.hls_byterange_file = function(path, audio_path, options)
+  options = options or {}
+  local data, size = map_file(path)
+  local fd = ffi.new("int[1]", ffi.C.open(audio_path, O_WRONLY_CREAT_TRUNC, ffi.cast("int", 420))) -- 0644
+  if fd[0] < 0 then
+    ffi.C.munmap(data, size)
+    error("Failed opening " .. audio_path)
+  end
+
+  local input = ffi.cast("const uint8_t *", data)
+  local input_options = setmetatable({input_size = size}, {__index = options})
+  local index_function = not options.index and memory_reader(input, size)
+  local read_function = audio_reader(input, size)
   local write_function = ffi.cast(callback, function(opaque, buf, buf_size)
-    output[#output + 1] = ffi.string(buf, buf_size)
-    return buf_size
+    return write_all(fd[0], buf, buf_size)
   end)
 
-  extract_audio(read_function, write_function)
+  local playlist, audio_playlist
+  local ok, err = pcall(function()
+    local map, not_ts = ts_program_tables(input, size)
+    if not_ts then
+      error("Not an MPEG-TS file: " .. path)
+    elseif not map then
+      error("No PAT/PMT in " .. path)
+    end
+    local index = options.index or build_index(index_function, input_options)
+    local segments = hls_segments(index, size, options)
+    local segment_pts = {}
+    for i, segment in ipairs(segments) do
+      segment_pts[i] = segment.pts
+    end
+    local audio = adts_sink(write_function, setmetatable({segment_pts = segment_pts}, {__index = options}))
+    demux(read_function, {audio}, input_options)
+    playlist = byterange_playlist(segments, options.uri or path, map)
+    audio_playlist = byterange_playlist(adts_segments(audio), options.audio_uri or audio_path)
+  end)
+  if index_function then
+    index_function:free()
+  end
   read_function:free()
   write_function:free()
-  return table.concat(output)
+
+  ffi.C.close(fd[0])
+  ffi.C.munmap(data, size)
+  if not ok then
+    error(err, 0)
+  end
+  return playlist, audio_playlist
+end
+
+-- extracts audio from the mmap'ed input file straight into out_path
+M.extract_audio_file = function(path, out_path, options)
+  options = options or {}
+  local data, size = map_file(path)
+  local fd = ffi.new("int[1]", ffi.C.open(out_path, O_WRONLY_CREAT_TRUNC, ffi.cast("int", 420))) -- 0644
+  if fd[0] < 0 then
+    ffi.C.munmap(data, size)
+    error("Failed opening " .. out_path)
+  end
+
+  local ok, err
+  local time_range = options.start_pts or options.end_pts
+  if use_native(options) then
+    ok, err = pcall(function()
+      av_assert(native.transmux_extract_audio(data, size, native.transmux_fd_write, fd))
+    end)
+  else
+    local read_function, seek_function = audio_reader(ffi.cast("const uint8_t *", data), size, time_range,
+      options.index)
+    local write_function = ffi.cast(callback, function(opaque, buf, buf_size)
+      return write_all(fd[0], buf, buf_size)
+    end)
+    ok, err = pcall(extract_audio, read_function, write_function,
+      setmetatable({input_size = size, input_seek_function = seek_function}, {__index = options}))
+    read_function:free()
+    write_function:free()
+    if seek_function then
+      seek_function:free()
+    end
+  end
+
+  ffi.C.close(fd[0])
+  ffi.C.munmap(data, size)
+  if not ok then
+    error(err, 0)
+  end
 end
 
 return M